@@ -0,0 +1,150 @@
+#include "ActivityMap.h"
+#include "LogBook.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t ActivityMap_Bucket(const ActivityMap* this, time_t timestamp);
+static void* ActivityMap_Alloc(size_t count, size_t size);
+
+ActivityMap ActivityMap_Init() {
+  return (ActivityMap){
+      .begin = 0,
+      .end = 0,
+      .bucketSeconds = 1,
+      .levelsSize = 0,
+      .levelStarts = {0},
+      .buckets = NULL,
+  };
+}
+
+void ActivityMap_Destroy(ActivityMap* this) {
+  free(this->buckets);
+  *this = ActivityMap_Init();
+}
+
+// Operations are counted from entries, ongoing nodes from status changes of NodeStats, which has to be built before
+void ActivityMap_Build(ActivityMap* this, const LogBook* logBook) {
+  ActivityMap_Destroy(this);
+  const NodeStats* stats = &logBook->stats;
+  this->begin = stats->begin;  // earliest and latest valid timestamp, entries need not be in time order
+  this->end = stats->end > stats->begin ? stats->end : stats->begin;
+  const time_t span = this->end - this->begin + 1;  // at least 1, so is bucketSeconds
+  this->bucketSeconds = (span + ACTIVITYMAP_BUCKETS - 1) / ACTIVITYMAP_BUCKETS;
+  const size_t bucketsSize = (span + this->bucketSeconds - 1) / this->bucketSeconds;
+
+  size_t total = 0;
+  for (size_t size = bucketsSize; this->levelsSize < ACTIVITYMAP_MAX_LEVELS; size = (size + 1) / 2) {
+    this->levelStarts[this->levelsSize++] = total;
+    total += size;
+    if (size == 1) {
+      break;
+    }
+  }
+  this->levelStarts[this->levelsSize] = total;
+  this->buckets = ActivityMap_Alloc(total, sizeof(ActivityBucket));
+
+  ActivityBucket* finest = this->buckets;
+  for (const LogEntry* entry = logBook->entries; entry < logBook->entries + logBook->entriesSize; ++entry) {
+    if (entry->operation < ACTIVITYMAP_OPERATIONS && entry->timestamp != 0) {  // wrong timestamp is 0
+      ++finest[ActivityMap_Bucket(this, entry->timestamp)].counts[entry->operation];
+    }
+  }
+
+  // node ongoing from one change to the next one counts in every bucket it touches, summed from differences
+  int64_t* differences = ActivityMap_Alloc(bucketsSize + 1, sizeof(int64_t));
+  for (size_t node = 0; node < stats->nodesSize; ++node) {
+    const NodeChange* first = stats->changes + stats->changeStarts[node];
+    const NodeChange* last = stats->changes + stats->changeStarts[node + 1];
+    const time_t end = stats->removed[node] ? stats->removed[node] : stats->end;
+    size_t covered = 0;  // buckets before it already count the node
+    for (const NodeChange* it = first; it < last; ++it) {
+      if (it->status != EStatus_Ongoing) {
+        continue;
+      }
+      const time_t until = it + 1 < last ? it[1].timestamp : end;
+      const size_t from = ActivityMap_Bucket(this, it->timestamp);
+      const size_t to = ActivityMap_Bucket(this, until > it->timestamp ? until : it->timestamp) + 1;
+      if (to > covered) {
+        ++differences[from > covered ? from : covered];
+        --differences[to];
+        covered = to;
+      }
+    }
+  }
+  int64_t ongoing = 0;
+  for (size_t i = 0; i < bucketsSize; ++i) {
+    ongoing += differences[i];
+    finest[i].ongoing = ongoing;
+  }
+  free(differences);
+
+  for (size_t level = 1; level < this->levelsSize; ++level) {
+    const ActivityBucket* children = this->buckets + this->levelStarts[level - 1];
+    const size_t childrenSize = this->levelStarts[level] - this->levelStarts[level - 1];
+    ActivityBucket* parents = this->buckets + this->levelStarts[level];
+    for (size_t i = 0; i < childrenSize; ++i) {
+      ActivityBucket* parent = &parents[i / 2];
+      for (size_t op = 0; op < ACTIVITYMAP_OPERATIONS; ++op) {
+        parent->counts[op] += children[i].counts[op];
+      }
+      parent->ongoing = children[i].ongoing > parent->ongoing ? children[i].ongoing : parent->ongoing;
+    }
+  }
+}
+
+// Pixel p covers time from + p * secondsPerPixel. Buckets are taken from the coarsest level not wider than pixel,
+// so every pixel sums few of them whatever the zoom.
+void ActivityMap_Resample(const ActivityMap* this,
+                          double from,
+                          double secondsPerPixel,
+                          ActivityBucket* pixels,
+                          size_t pixelsSize) {
+  memset(pixels, 0, pixelsSize * sizeof(ActivityBucket));
+  if (this->levelsSize == 0 || secondsPerPixel <= 0) {
+    return;
+  }
+  size_t level = 0;
+  while (level + 1 < this->levelsSize && (double)(this->bucketSeconds << (level + 1)) <= secondsPerPixel) {
+    ++level;
+  }
+  const ActivityBucket* buckets = this->buckets + this->levelStarts[level];
+  const double bucketsSize = this->levelStarts[level + 1] - this->levelStarts[level];
+  const double bucketSeconds = (double)(this->bucketSeconds << level);
+
+  double position = (from - this->begin) / bucketSeconds;
+  for (size_t p = 0; p < pixelsSize; ++p) {
+    const double next = position + secondsPerPixel / bucketSeconds;
+    // bucket belongs to pixel its start falls into, pixel narrower than bucket shows the bucket it lies in
+    double firstBucket = ceil(position);
+    double lastBucket = ceil(next);
+    if (firstBucket >= lastBucket) {
+      firstBucket = floor(position);
+      lastBucket = firstBucket + 1;
+    }
+    for (double b = fmax(firstBucket, 0); b < lastBucket && b < bucketsSize; ++b) {
+      const ActivityBucket* bucket = &buckets[(size_t)b];
+      for (size_t op = 0; op < ACTIVITYMAP_OPERATIONS; ++op) {
+        pixels[p].counts[op] += bucket->counts[op];
+      }
+      pixels[p].ongoing = bucket->ongoing > pixels[p].ongoing ? bucket->ongoing : pixels[p].ongoing;
+    }
+    position = next;
+  }
+}
+
+static size_t ActivityMap_Bucket(const ActivityMap* this, time_t timestamp) {
+  const time_t clamped = timestamp < this->begin ? this->begin : timestamp > this->end ? this->end : timestamp;
+  return (clamped - this->begin) / this->bucketSeconds;
+}
+
+static void* ActivityMap_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for ActivityMap");
+    exit(10);
+  }
+  return memory;
+}
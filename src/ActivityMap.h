@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#define ACTIVITYMAP_OPERATIONS 5  // EOperation_Add .. EOperation_Remove
+#define ACTIVITYMAP_BUCKETS 16384  // at most, in the finest level
+#define ACTIVITYMAP_MAX_LEVELS 16
+
+typedef struct LogBook LogBook;
+
+typedef struct ActivityBucket {
+  uint32_t counts[ACTIVITYMAP_OPERATIONS];  // entries of operation
+  uint32_t ongoing;                         // peak number of nodes ongoing in bucket
+} ActivityBucket;
+
+// Pyramid of log activity per time bucket. Every level halves number of buckets of previous one, so any time range
+// is covered by few buckets per pixel.
+typedef struct ActivityMap {
+  time_t begin;
+  time_t end;
+  time_t bucketSeconds;  // of level 0
+  size_t levelsSize;
+  size_t levelStarts[ACTIVITYMAP_MAX_LEVELS + 1];  // offsets of levels into buckets, the finest first
+  ActivityBucket* buckets;
+} ActivityMap;
+
+ActivityMap ActivityMap_Init();
+void ActivityMap_Destroy(ActivityMap* this);
+void ActivityMap_Build(ActivityMap* this, const LogBook* logBook);
+void ActivityMap_Resample(const ActivityMap* this,
+                          double from,
+                          double secondsPerPixel,
+                          ActivityBucket* pixels,
+                          size_t pixelsSize);
@@ -3,7 +3,10 @@
 #include "DynamicArray.h"
 #include "Graph.h"
 #include "Gui.h"
+#include "Loader.h"
 #include "LogBook.h"
+#include "Profiler.h"
+#include "Trace.h"
 
 #include <stddef.h>
 #include <stdio.h>
@@ -14,10 +17,12 @@ typedef struct App {
   bool running;
   Core core;
   Gui* gui;
+  Loader* loader;
 } App;
 
 static void App_Loop(App* this);
 static void App_LoadSelectedLogBook(App* this);
+static void App_HandleLoader(App* this);
 
 size_t App_SizeOf() {
   return sizeof(App);
@@ -28,13 +33,19 @@ void App_Init(App* this) {
                .core =
                    {
                        .selectedFileName = "",
+                       .loading = false,
+                       .cancelLoading = false,
+                       .loadingProgress = 0.0,
                        .logBook = LogBook_Init(),
                        .currentLog = 0,
                        .oldGraph = Graph_Init(NULL, 0),
                        .currentGraph = Graph_Init(NULL, 0),
+                       .retention = {.entries = 0, .seconds = 0},
                    },
-               .gui = malloc(Gui_SizeOf())};
+               .gui = malloc(Gui_SizeOf()),
+               .loader = malloc(Loader_SizeOf())};
   Gui_Init(this->gui);
+  Loader_Init(this->loader);
 }
 
 void Core_Destroy(Core* this) {
@@ -44,23 +55,34 @@ void Core_Destroy(Core* this) {
 }
 
 void App_Destroy(App* this) {
+  Loader_Destroy(this->loader);
+  free(this->loader);
+  Trace_Close();
   Gui_Destroy(this->gui);
   Core_Destroy(&this->core);
 }
 
 void App_Configure(App* this, Config config) {
-  if (config.filePath) {
-    strncpy(this->core.selectedFileName, config.filePath, sizeof(this->core.selectedFileName));
-    Gui_SetNewFileName(this->gui, config.filePath);
+  if (config.traceFile) {
+    Trace_Open(config.traceFile);
+  }
+  Loader_SetVerbosity(this->loader, config.verbosity);
+  this->core.retention = config.retention;
+  if (config.sourcesSize == 1 && !config.sources[0].namePrefix) {
+    strncpy(this->core.selectedFileName, config.sources[0].fileName, sizeof(this->core.selectedFileName));
     App_LoadSelectedLogBook(this);
+  } else if (config.sourcesSize > 0) {  // several logs, or one with prefix of its node names
+    Loader_StartMerged(this->loader, config.sources, config.sourcesSize);
   }
   Gui_SetActiveStyle(this->gui, config.style);
+  Gui_SetFrameRate(this->gui, config.targetFps, config.idleMode);
 }
 
 void App_Run(App* this) {
   Gui_InitWindow(this->gui, "DepView");
 
   while (this->running) {
+    PROFILER_SCOPE(EPhase_Frame);
     App_Loop(this);
     Gui_Draw(this->gui, &this->core);
     this->running = !Gui_ShouldWindowClose();
@@ -70,24 +92,58 @@ void App_Run(App* this) {
 }
 
 static void App_Loop(App* this) {
+  PROFILER_COLLECT();
   Gui_Loop(this->gui, &this->core);
 
   if (this->core.selectedFileName[0] != '\0'){
-    Gui_SetNewFileName(this->gui, this->core.selectedFileName);
     App_LoadSelectedLogBook(this);
   }
+  App_HandleLoader(this);
 }
 
 static void App_LoadSelectedLogBook(App* this) {
   printf("Loading log from %s\n", this->core.selectedFileName);
-  if (LogBook_IsLoaded(&this->core.logBook)) {
-    LogBook_Destroy(&this->core.logBook);
-    this->core.logBook = LogBook_Init();
-  }
-  LogBook_Load(&this->core.logBook, this->core.selectedFileName);
-  printf("Loaded %zu logs\n", this->core.logBook.entriesSize);
-  this->core.currentLog = 0;
-  LogBook_Print(&this->core.logBook);
-  Gui_TriggerGraphChange(this->gui);
+  Loader_Start(this->loader, this->core.selectedFileName);
   this->core.selectedFileName[0] = '\0';
 }
+
+// Previous LogBook stays browsable until the new one is completely loaded
+static void App_HandleLoader(App* this) {
+  if (this->core.cancelLoading) {
+    Loader_Cancel(this->loader);
+    this->core.cancelLoading = false;
+  }
+  this->core.loading = Loader_IsRunning(this->loader);
+  this->core.loadingProgress = Loader_GetProgress(this->loader);
+  if (this->core.loading) {
+    Gui_RequestRedraw(this->gui);
+    return;
+  }
+
+  LogBook loaded;
+  switch (Loader_Poll(this->loader, &loaded)) {
+    case ELoaderState_Finished:
+      LogBook_Destroy(&this->core.logBook);
+      this->core.logBook = loaded;
+      PROFILER_COUNTER(ECounter_Entries, this->core.logBook.entriesSize);
+      printf("Loaded %zu logs, %zu issues\n", this->core.logBook.entriesSize,
+             Diagnostics_Count(&this->core.logBook.diagnostics));
+      this->core.currentLog = 0;
+      if (this->core.logBook.diagnostics.verbosity >= EVerbosity_Verbose) {
+        LogBook_Print(&this->core.logBook);
+      }
+      Gui_SetNewFileName(this->gui, Loader_GetFileName(this->loader));
+      Gui_TriggerGraphChange(this->gui);
+      break;
+    case ELoaderState_Cancelled:
+      printf("Loading of %s cancelled\n", Loader_GetFileName(this->loader));
+      Gui_RequestRedraw(this->gui);
+      break;
+    case ELoaderState_Failed:
+      printf("Loading of %s failed\n", Loader_GetFileName(this->loader));
+      Gui_RequestRedraw(this->gui);
+      break;
+    default:
+      break;
+  }
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "Diagnostics.h"
+#include "Graph.h"
+
+#include <stdbool.h>
 #include <stddef.h>
 
 typedef struct App App;
@@ -7,8 +11,14 @@ typedef struct App App;
 typedef struct Core Core;
 
 typedef struct Config {
-    char* filePath;
+    const LogSource* sources;  // logs merged into one
+    size_t sourcesSize;
     int style;
+    int targetFps;
+    bool idleMode;
+    EVerbosity verbosity;
+    char* traceFile;
+    Retention retention;
 } Config;
 
 size_t App_SizeOf();
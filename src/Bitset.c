@@ -0,0 +1,68 @@
+#include "Bitset.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t Bitset_WordsSize(size_t size);
+static size_t Bitset_LowestBit(uint64_t word);
+
+Bitset Bitset_Init() {
+  return (Bitset){.words = NULL, .size = 0};
+}
+
+void Bitset_Destroy(Bitset* this) {
+  free(this->words);
+  *this = Bitset_Init();
+}
+
+void Bitset_Resize(Bitset* this, size_t size) {
+  if (Bitset_WordsSize(size) != Bitset_WordsSize(this->size) || this->words == NULL) {
+    free(this->words);
+    this->words = calloc(Bitset_WordsSize(size) ? Bitset_WordsSize(size) : 1, sizeof(uint64_t));
+    if (this->words == NULL) {
+      perror("Cannot calloc memory for Bitset");
+      exit(10);
+    }
+  } else {
+    memset(this->words, 0, Bitset_WordsSize(size) * sizeof(uint64_t));
+  }
+  this->size = size;
+}
+
+void Bitset_Clear(Bitset* this) {
+  memset(this->words, 0, Bitset_WordsSize(this->size) * sizeof(uint64_t));
+}
+
+size_t Bitset_Next(const Bitset* this, size_t from) {
+  if (from >= this->size) {
+    return this->size;
+  }
+  size_t word = from / 64;
+  uint64_t bits = this->words[word] & (~(uint64_t)0 << (from % 64));
+  while (bits == 0) {
+    if (++word == Bitset_WordsSize(this->size)) {
+      return this->size;
+    }
+    bits = this->words[word];
+  }
+  const size_t next = word * 64 + Bitset_LowestBit(bits);
+  return next < this->size ? next : this->size;
+}
+
+static size_t Bitset_WordsSize(size_t size) {
+  return (size + 63) / 64;
+}
+
+static size_t Bitset_LowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(word);
+#else
+  size_t bit = 0;
+  while (!(word & 1)) {
+    word >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
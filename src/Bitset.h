@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct Bitset {
+  uint64_t* words;
+  size_t size;  // in bits
+} Bitset;
+
+Bitset Bitset_Init();
+void Bitset_Destroy(Bitset* this);
+void Bitset_Resize(Bitset* this, size_t size);  // all bits are cleared
+void Bitset_Clear(Bitset* this);
+size_t Bitset_Next(const Bitset* this, size_t from);  // first set bit not before from, size when none
+
+#define Bitset_Set(this, i) ((this)->words[(i) / 64] |= (uint64_t)1 << ((i) % 64))
+#define Bitset_Test(this, i) (((this)->words[(i) / 64] >> ((i) % 64)) & 1)
@@ -3,10 +3,16 @@
 #include "LogBook.h"
 #include "Graph.h"
 
+#include <stdbool.h>
+
 typedef struct Core {
   char selectedFileName[2048];
+  bool loading;
+  bool cancelLoading;
+  float loadingProgress;
   LogBook logBook;
   size_t currentLog;
   Graph oldGraph;
   Graph currentGraph;
+  Retention retention;  // of every graph built for logBook
 } Core;
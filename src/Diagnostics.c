@@ -0,0 +1,109 @@
+#include "Diagnostics.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* const DIAGNOSTIC_KIND_NAMES[EDiagnostic_KindsSize] = {
+    "wrong timestamp",
+    "wrong operation",
+    "unknown node name",
+    "wrong status",
+};
+
+Diagnostics Diagnostics_Init(EVerbosity verbosity) {
+  return (Diagnostics){
+      .verbosity = verbosity,
+      .counts = {0},
+      .records = DynamicArray_Make(Diagnostic),
+  };
+}
+
+void Diagnostics_Destroy(Diagnostics* this) {
+  if (this->records) {
+    DynamicArray_Destroy(this->records);
+    free(this->records);
+  }
+  this->records = NULL;
+}
+
+// Every diagnostic is counted, but only first DIAGNOSTICS_MAX_RECORDS_PER_KIND of each kind are kept
+void Diagnostics_Report(Diagnostics* this, EDiagnosticKind kind, size_t lineNumber, const char* format, ...) {
+  if (++this->counts[kind] > DIAGNOSTICS_MAX_RECORDS_PER_KIND) {
+    return;
+  }
+  Diagnostic record = {.kind = kind, .lineNumber = lineNumber};
+  va_list args;
+  va_start(args, format);
+  vsnprintf(record.text, sizeof(record.text), format, args);
+  va_end(args);
+  DynamicArray_Push(this->records, record);
+
+  if (this->verbosity >= EVerbosity_Errors) {
+    char text[160];
+    Diagnostics_FormatRecord(&record, text, sizeof(text));
+    fprintf(stderr, "%s\n", text);
+  }
+}
+
+void Diagnostics_Trace(const Diagnostics* this, const char* format, ...) {
+  if (this->verbosity < EVerbosity_Verbose) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+// Records kept by earlier load of the same log, printed as if they were reported again
+void Diagnostics_Restore(Diagnostics* this, const size_t* counts, const Diagnostic* records, size_t recordsSize) {
+  for (size_t i = 0; i < EDiagnostic_KindsSize; ++i) {
+    this->counts[i] += counts[i];
+  }
+  for (const Diagnostic* record = records; record < records + recordsSize; ++record) {
+    DynamicArray_Push(this->records, *record);
+    if (this->verbosity >= EVerbosity_Errors) {
+      char text[160];
+      Diagnostics_FormatRecord(record, text, sizeof(text));
+      fprintf(stderr, "%s\n", text);
+    }
+  }
+}
+
+size_t Diagnostics_Count(const Diagnostics* this) {
+  size_t count = 0;
+  for (size_t i = 0; i < EDiagnostic_KindsSize; ++i) {
+    count += this->counts[i];
+  }
+  return count;
+}
+
+size_t Diagnostics_RecordsSize(const Diagnostics* this) {
+  return DynamicArray_Size(Diagnostic, this->records);
+}
+
+const Diagnostic* Diagnostics_Record(const Diagnostics* this, size_t index) {
+  return DynamicArray_Begin(Diagnostic, this->records) + index;
+}
+
+void Diagnostics_FormatRecord(const Diagnostic* record, char* text, size_t textSize) {
+  snprintf(text, textSize, "line %zu: %s", record->lineNumber, record->text);
+}
+
+void Diagnostics_Print(const Diagnostics* this, FILE* stream) {
+  char text[160];
+  for (size_t i = 0; i < Diagnostics_RecordsSize(this); ++i) {
+    Diagnostics_FormatRecord(Diagnostics_Record(this, i), text, sizeof(text));
+    fprintf(stream, "%s\n", text);
+  }
+  for (size_t i = 0; i < EDiagnostic_KindsSize; ++i) {
+    if (this->counts[i] > 0) {
+      fprintf(stream, "%zu x %s", this->counts[i], DIAGNOSTIC_KIND_NAMES[i]);
+      if (this->counts[i] > DIAGNOSTICS_MAX_RECORDS_PER_KIND) {
+        fprintf(stream, " (%zu not recorded)", this->counts[i] - DIAGNOSTICS_MAX_RECORDS_PER_KIND);
+      }
+      fprintf(stream, "\n");
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "DynamicArray.h"
+
+#include <stddef.h>
+#include <stdio.h>
+
+#define DIAGNOSTICS_MAX_RECORDS_PER_KIND 256
+
+typedef enum { EVerbosity_Quiet, EVerbosity_Errors, EVerbosity_Verbose } EVerbosity;
+
+typedef enum {
+  EDiagnostic_WrongTimestamp,
+  EDiagnostic_WrongOperation,
+  EDiagnostic_UnknownNodeName,
+  EDiagnostic_WrongStatus,
+  EDiagnostic_KindsSize
+} EDiagnosticKind;
+
+typedef struct Diagnostic {
+  EDiagnosticKind kind;
+  size_t lineNumber;
+  char text[128];
+} Diagnostic;
+
+typedef struct Diagnostics {
+  EVerbosity verbosity;
+  size_t counts[EDiagnostic_KindsSize];
+  DynamicArray* records;
+} Diagnostics;
+
+Diagnostics Diagnostics_Init(EVerbosity verbosity);
+void Diagnostics_Destroy(Diagnostics* this);
+void Diagnostics_Report(Diagnostics* this, EDiagnosticKind kind, size_t lineNumber, const char* format, ...);
+void Diagnostics_Trace(const Diagnostics* this, const char* format, ...);
+void Diagnostics_Restore(Diagnostics* this, const size_t* counts, const Diagnostic* records, size_t recordsSize);
+size_t Diagnostics_Count(const Diagnostics* this);
+size_t Diagnostics_RecordsSize(const Diagnostics* this);
+const Diagnostic* Diagnostics_Record(const Diagnostics* this, size_t index);
+void Diagnostics_FormatRecord(const Diagnostic* record, char* text, size_t textSize);
+void Diagnostics_Print(const Diagnostics* this, FILE* stream);
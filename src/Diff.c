@@ -0,0 +1,183 @@
+#include "Diff.h"
+#include "LogBook.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void Diff_Mark(Diff* this, size_t node, int mark);
+static void Diff_PushEdges(Diff* this,
+                           const NodeStats* stats,
+                           size_t entry,
+                           const LogEntry* log,
+                           size_t node,
+                           int mark);
+static int Diff_CompareEdges(const void* lhs, const void* rhs);
+static void* Diff_Grow(void* items, size_t* capacity, size_t itemSize);
+
+Diff Diff_Init() {
+  return (Diff){
+      .from = 0,
+      .to = 0,
+      .marks = NULL,
+      .marksSize = 0,
+      .touched = NULL,
+      .touchedSize = 0,
+      .touchedCapacity = 0,
+      .edges = NULL,
+      .edgesSize = 0,
+      .edgesCapacity = 0,
+      .nodeCounts = {0},
+      .edgeCounts = {0},
+  };
+}
+
+void Diff_Destroy(Diff* this) {
+  free(this->marks);
+  free(this->touched);
+  free(this->edges);
+  *this = Diff_Init();
+}
+
+// Only entries after older and up to newer one are visited. Marks of previous diff are cleared through its touched
+// nodes, so nothing is proportional to size of the log, except first diff of a newly loaded one.
+void Diff_Build(Diff* this, const LogBook* logBook, size_t from, size_t to) {
+  const NodeStats* stats = &logBook->stats;
+  if (this->marksSize != stats->nodesSize) {
+    free(this->marks);
+    this->marksSize = stats->nodesSize;
+    this->marks = calloc(this->marksSize ? this->marksSize : 1, sizeof(uint8_t));
+    if (this->marks == NULL) {
+      perror("Cannot calloc memory for Diff");
+      exit(10);
+    }
+  } else {
+    for (size_t i = 0; i < this->touchedSize; ++i) {
+      this->marks[this->touched[i]] = EDiffMark_None;
+    }
+  }
+  this->touchedSize = 0;
+  this->edgesSize = 0;
+  memset(this->nodeCounts, 0, sizeof(this->nodeCounts));
+  memset(this->edgeCounts, 0, sizeof(this->edgeCounts));
+  this->from = from < to ? from : to;
+  this->to = from < to ? to : from;
+  if (this->to >= logBook->entriesSize) {
+    return;
+  }
+
+  for (size_t i = this->from + 1; i <= this->to; ++i) {
+    const LogEntry* entry = &logBook->entries[i];
+    const size_t node = stats->entryNodes[i];
+    if (node == (size_t)-1) {
+      continue;
+    }
+    switch (entry->operation) {
+      case EOperation_Add:
+        Diff_Mark(this, node, this->marks[node] == EDiffMark_Removed ? EDiffMark_Removed : EDiffMark_Added);
+        Diff_PushEdges(this, stats, i, entry, node, EDiffMark_Added);
+        break;
+      case EOperation_Remove:  // node added within range still exists, finished, at newer entry
+        Diff_Mark(this, node, this->marks[node] == EDiffMark_Added ? EDiffMark_Added : EDiffMark_Removed);
+        break;
+      case EOperation_StatusChange:
+        Diff_Mark(this, node, this->marks[node] == EDiffMark_None ? EDiffMark_StatusChanged : this->marks[node]);
+        break;
+      case EOperation_AddDependency:
+        Diff_PushEdges(this, stats, i, entry, node, EDiffMark_Added);
+        break;
+      case EOperation_RemoveDependency:
+        Diff_PushEdges(this, stats, i, entry, node, EDiffMark_Removed);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // status changed back and forth within range is not a change
+  for (size_t i = 0; i < this->touchedSize; ++i) {
+    const size_t node = this->touched[i];
+    if (this->marks[node] == EDiffMark_StatusChanged &&
+        NodeStats_StatusAt(stats, node, this->from) == NodeStats_StatusAt(stats, node, this->to)) {
+      this->marks[node] = EDiffMark_None;
+    }
+    ++this->nodeCounts[this->marks[node]];
+  }
+
+  // edge added and removed within range cancel each other
+  qsort(this->edges, this->edgesSize, sizeof(DiffEdge), Diff_CompareEdges);
+  size_t netSize = 0;
+  for (size_t i = 0; i < this->edgesSize;) {
+    size_t j = i;
+    int net = 0;
+    for (; j < this->edgesSize && Diff_CompareEdges(&this->edges[i], &this->edges[j]) == 0; ++j) {
+      net += this->edges[j].mark == EDiffMark_Added ? 1 : -1;
+    }
+    if (net != 0) {
+      this->edges[netSize] = this->edges[i];
+      this->edges[netSize].mark = net > 0 ? EDiffMark_Added : EDiffMark_Removed;
+      ++this->edgeCounts[this->edges[netSize].mark];
+      ++netSize;
+    }
+    i = j;
+  }
+  this->edgesSize = netSize;
+}
+
+int Diff_NodeMark(const Diff* this, size_t node) {
+  return node < this->marksSize ? this->marks[node] : EDiffMark_None;
+}
+
+int Diff_EdgeMark(const Diff* this, size_t source, size_t destination) {
+  const DiffEdge key = {.source = source, .destination = destination};
+  const DiffEdge* found = bsearch(&key, this->edges, this->edgesSize, sizeof(DiffEdge), Diff_CompareEdges);
+  return found ? found->mark : EDiffMark_None;
+}
+
+static void Diff_Mark(Diff* this, size_t node, int mark) {
+  if (this->marks[node] == EDiffMark_None) {
+    if (this->touchedSize == this->touchedCapacity) {
+      this->touched = Diff_Grow(this->touched, &this->touchedCapacity, sizeof(size_t));
+    }
+    this->touched[this->touchedSize++] = node;
+  }
+  this->marks[node] = mark;
+}
+
+// Dependencies are edges from them to node, as in Graph, which skips dependencies not added before the entry
+static void Diff_PushEdges(Diff* this,
+                           const NodeStats* stats,
+                           size_t entry,
+                           const LogEntry* log,
+                           size_t node,
+                           int mark) {
+  for (const size_t* dependency = log->dependencies; *dependency != 0; ++dependency) {
+    const size_t source = stats->nodeOfName[*dependency];
+    if (source == 0 || stats->changes[stats->changeStarts[source - 1]].entry >= entry) {
+      continue;
+    }
+    if (this->edgesSize == this->edgesCapacity) {
+      this->edges = Diff_Grow(this->edges, &this->edgesCapacity, sizeof(DiffEdge));
+    }
+    this->edges[this->edgesSize++] = (DiffEdge){.source = source - 1, .destination = node, .mark = mark};
+  }
+}
+
+static int Diff_CompareEdges(const void* lhs, const void* rhs) {
+  const DiffEdge* left = lhs;
+  const DiffEdge* right = rhs;
+  if (left->source != right->source) {
+    return left->source < right->source ? -1 : 1;
+  }
+  return left->destination < right->destination ? -1 : left->destination > right->destination;
+}
+
+static void* Diff_Grow(void* items, size_t* capacity, size_t itemSize) {
+  *capacity = *capacity ? *capacity * 2 : 64;
+  items = realloc(items, *capacity * itemSize);
+  if (items == NULL) {
+    perror("Cannot realloc memory for Diff");
+    exit(10);
+  }
+  return items;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct LogBook LogBook;
+
+typedef enum { EDiffMark_None, EDiffMark_Added, EDiffMark_Removed, EDiffMark_StatusChanged, EDiffMark_Size } EDiffMark;
+
+typedef struct DiffEdge {
+  size_t source;
+  size_t destination;
+  int mark;  // EDiffMark_Added or EDiffMark_Removed
+} DiffEdge;
+
+// Changes between snapshots at two entries, collected from entries between them only. Nodes are those of NodeStats,
+// which are also Node.id of Graph.nodes.
+typedef struct Diff {
+  size_t from;  // older entry
+  size_t to;    // newer entry
+  uint8_t* marks;  // EDiffMark of every node, only touched ones are not None
+  size_t marksSize;
+  size_t* touched;  // nodes marked by last Diff_Build, cleared by the next one
+  size_t touchedSize;
+  size_t touchedCapacity;
+  DiffEdge* edges;  // sorted by source and destination
+  size_t edgesSize;
+  size_t edgesCapacity;
+  size_t nodeCounts[EDiffMark_Size];
+  size_t edgeCounts[EDiffMark_Size];
+} Diff;
+
+Diff Diff_Init();
+void Diff_Destroy(Diff* this);
+void Diff_Build(Diff* this, const LogBook* logBook, size_t from, size_t to);
+int Diff_NodeMark(const Diff* this, size_t node);
+int Diff_EdgeMark(const Diff* this, size_t source, size_t destination);
@@ -0,0 +1,198 @@
+#include "Export.h"
+#include "Workspace.h"
+
+#include <raylib.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define EXPORT_BUFFER_SIZE (1024 * 1024)
+
+typedef struct StatusPalette {
+  const char* fill;
+  const char* stroke;
+} StatusPalette;
+
+// raygui default style colours of normal, focused and disabled buttons, as used by diagram for these statuses
+static const StatusPalette PALETTE[EStatus_Size] = {
+    {.fill = "#c9c9c9", .stroke = "#838383"},
+    {.fill = "#c9effe", .stroke = "#5bb2d9"},
+    {.fill = "#e6e9e9", .stroke = "#b5c1c2"},
+};
+
+static const char* const EXTENSIONS[EExportFormat_Size] = {"svg", "dot", "json"};
+
+static void Export_WriteSvg(FILE* stream, const Graph* graph, const LogBook* logBook, const Vector2* coordinates);
+static void Export_WriteDot(FILE* stream, const Graph* graph, const LogBook* logBook, const Vector2* coordinates);
+static void Export_WriteJson(FILE* stream, const Graph* graph, const LogBook* logBook, const Vector2* coordinates);
+static void Export_WriteXmlString(FILE* stream, const char* text);
+static void Export_WriteDotString(FILE* stream, const char* text);
+
+bool Export_Write(const char* fileName,
+                  EExportFormat format,
+                  const Graph* graph,
+                  const LogBook* logBook,
+                  const Vector2* coordinates) {
+  FILE* stream = fopen(fileName, "w");
+  if (stream == NULL) {
+    perror("Cannot open export file");
+    return false;
+  }
+  char* buffer = malloc(EXPORT_BUFFER_SIZE);
+  if (buffer) {
+    setvbuf(stream, buffer, _IOFBF, EXPORT_BUFFER_SIZE);
+  }
+
+  switch (format) {
+    case EExportFormat_Svg:
+      Export_WriteSvg(stream, graph, logBook, coordinates);
+      break;
+    case EExportFormat_Dot:
+      Export_WriteDot(stream, graph, logBook, coordinates);
+      break;
+    default:
+      Export_WriteJson(stream, graph, logBook, coordinates);
+      break;
+  }
+
+  const bool written = !ferror(stream);
+  if (fclose(stream) != 0 || !written) {
+    perror("Cannot write export file");
+    free(buffer);
+    return false;
+  }
+  free(buffer);
+  return true;
+}
+
+bool Export_FormatFromFileName(const char* fileName, EExportFormat* format) {
+  const char* dot = strrchr(fileName, '.');
+  if (dot == NULL) {
+    return false;
+  }
+  for (size_t i = 0; i < EExportFormat_Size; ++i) {
+    if (0 == strcasecmp(dot + 1, EXTENSIONS[i])) {
+      *format = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char* Export_Extension(EExportFormat format) {
+  return EXTENSIONS[format];
+}
+
+void Export_WriteJsonString(FILE* stream, const char* text) {
+  fputc('"', stream);
+  for (const unsigned char* it = (const unsigned char*)text; *it != '\0'; ++it) {
+    if (*it == '"' || *it == '\\') {
+      fprintf(stream, "\\%c", *it);
+    } else if (*it < 0x20) {
+      fprintf(stream, "\\u%04x", *it);
+    } else {
+      fputc(*it, stream);
+    }
+  }
+  fputc('"', stream);
+}
+
+static void Export_WriteSvg(FILE* stream, const Graph* graph, const LogBook* logBook, const Vector2* coordinates) {
+  const Vector2 nodeSize = Workspace_NodeSize();
+  Vector2 size = {0, 0};
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    size.x = coordinates[i].x > size.x ? coordinates[i].x : size.x;
+    size.y = coordinates[i].y > size.y ? coordinates[i].y : size.y;
+  }
+  size.x += 2 * nodeSize.x;
+  size.y += 2 * nodeSize.y;
+
+  fprintf(stream, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\">\n", size.x, size.y);
+  fprintf(stream, "<style>text{font:10px sans-serif;text-anchor:middle;dominant-baseline:central}"
+                  "polyline{fill:none;stroke:#838383}");
+  for (size_t i = 0; i < EStatus_Size; ++i) {
+    fprintf(stream, ".%s{fill:%s;stroke:%s}", LogBook_StatusName(i), PALETTE[i].fill, PALETTE[i].stroke);
+  }
+  fprintf(stream, "</style>\n");
+
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    Vector2 strip[WORKSPACE_EDGE_STRIP_SIZE];
+    Workspace_EdgeStrip(coordinates[edge->source], coordinates[edge->destination], edge->source, strip);
+    fprintf(stream, "<polyline points=\"");
+    for (size_t i = 0; i < WORKSPACE_EDGE_STRIP_SIZE; ++i) {
+      fprintf(stream, i == 0 ? "%.1f,%.1f" : " %.1f,%.1f", strip[i].x, strip[i].y);
+    }
+    fprintf(stream, "\"/>\n");
+  }
+
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    const Node* node = &graph->nodes[i];
+    fprintf(stream, "<g class=\"%s\"><rect x=\"%.1f\" y=\"%.1f\" width=\"%.0f\" height=\"%.0f\"/>",
+            LogBook_StatusName(node->status), coordinates[i].x, coordinates[i].y, nodeSize.x, nodeSize.y);
+    fprintf(stream, "<text x=\"%.1f\" y=\"%.1f\" stroke=\"none\" fill=\"#000\">", coordinates[i].x + nodeSize.x / 2,
+            coordinates[i].y + nodeSize.y / 2);
+    Export_WriteXmlString(stream, LogBook_GetNodeName(logBook, node->nodeName));
+    fprintf(stream, "</text></g>\n");
+  }
+  fprintf(stream, "</svg>\n");
+}
+
+// Positions are given in points with y axis pointing up, so `neato -n` keeps DepView layout
+static void Export_WriteDot(FILE* stream, const Graph* graph, const LogBook* logBook, const Vector2* coordinates) {
+  const Vector2 nodeSize = Workspace_NodeSize();
+  fprintf(stream, "digraph DepView {\n");
+  fprintf(stream, "  node [shape=box, style=filled, width=%.3f, height=%.3f];\n", nodeSize.x / 72, nodeSize.y / 72);
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    const Node* node = &graph->nodes[i];
+    fprintf(stream, "  n%zu [label=", i);
+    Export_WriteDotString(stream, LogBook_GetNodeName(logBook, node->nodeName));
+    fprintf(stream, ", class=\"%s\", fillcolor=\"%s\", color=\"%s\", pos=\"%.1f,%.1f\"];\n",
+            LogBook_StatusName(node->status), PALETTE[node->status].fill, PALETTE[node->status].stroke,
+            coordinates[i].x + nodeSize.x / 2, -(coordinates[i].y + nodeSize.y / 2));
+  }
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    fprintf(stream, "  n%zu -> n%zu;\n", edge->source, edge->destination);
+  }
+  fprintf(stream, "}\n");
+}
+
+static void Export_WriteJson(FILE* stream, const Graph* graph, const LogBook* logBook, const Vector2* coordinates) {
+  fprintf(stream, "{\"nodes\":[");
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    const Node* node = &graph->nodes[i];
+    fprintf(stream, i == 0 ? "\n{\"name\":" : ",\n{\"name\":");
+    Export_WriteJsonString(stream, LogBook_GetNodeName(logBook, node->nodeName));
+    fprintf(stream, ",\"status\":\"%s\",\"timestamp\":%ld,\"x\":%.1f,\"y\":%.1f}", LogBook_StatusName(node->status),
+            (long)node->timestamp, coordinates[i].x, coordinates[i].y);
+  }
+  fprintf(stream, "],\n\"edges\":[");
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    fprintf(stream, "%s{\"source\":%zu,\"destination\":%zu}", edge == graph->edges ? "\n" : ",\n", edge->source,
+            edge->destination);
+  }
+  fprintf(stream, "]}\n");
+}
+
+// DOT quoted string escapes only quote and backslash, other bytes are written as they are
+static void Export_WriteDotString(FILE* stream, const char* text) {
+  fputc('"', stream);
+  for (const char* it = text; *it != '\0'; ++it) {
+    if (*it == '"' || *it == '\\') {
+      fputc('\\', stream);
+    }
+    fputc(*it, stream);
+  }
+  fputc('"', stream);
+}
+
+static void Export_WriteXmlString(FILE* stream, const char* text) {
+  for (const char* it = text; *it != '\0'; ++it) {
+    switch (*it) {  // clang-format off
+      case '<': fputs("&lt;", stream); break;
+      case '>': fputs("&gt;", stream); break;
+      case '&': fputs("&amp;", stream); break;
+      case '"': fputs("&quot;", stream); break;
+      default: fputc(*it, stream); break;
+    }  // clang-format on
+  }
+}
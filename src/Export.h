@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Graph.h"
+#include "LogBook.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+typedef enum { EExportFormat_Svg, EExportFormat_Dot, EExportFormat_Json, EExportFormat_Size } EExportFormat;
+
+// Streams graph with its diagram coordinates (one per node) to file, nothing is built in memory
+bool Export_Write(const char* fileName,
+                  EExportFormat format,
+                  const Graph* graph,
+                  const LogBook* logBook,
+                  const Vector2* coordinates);
+bool Export_FormatFromFileName(const char* fileName, EExportFormat* format);
+const char* Export_Extension(EExportFormat format);
+void Export_WriteJsonString(FILE* stream, const char* text);
@@ -0,0 +1,420 @@
+#include "Filter.h"
+#include "LogBook.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct FilterParser {
+  Filter* filter;
+  const char* text;
+  const char* at;
+  size_t depth;  // of stack after instructions emitted so far
+} FilterParser;
+
+static bool Filter_ParseOr(FilterParser* parser);
+static bool Filter_ParseAnd(FilterParser* parser);
+static bool Filter_ParseUnary(FilterParser* parser);
+static bool Filter_ParseTerm(FilterParser* parser);
+static bool Filter_ParseCompare(FilterParser* parser, int* compare);
+static bool Filter_ParseName(FilterParser* parser, FilterInstruction* instruction);
+static bool Filter_ParseAge(FilterParser* parser, FilterInstruction* instruction);
+static size_t Filter_ParseWord(FilterParser* parser, char* word, size_t size);
+static bool Filter_Accept(FilterParser* parser, const char* token);
+static bool Filter_Emit(FilterParser* parser, FilterInstruction instruction);
+static bool Filter_Fail(FilterParser* parser, const char* message);
+static void Filter_Test(Filter* this,
+                        FilterInstruction* instruction,
+                        const Graph* graph,
+                        const struct LogBook* logBook,
+                        time_t now,
+                        Bitset* result);
+static void Filter_MatchNames(const Filter* this,
+                              FilterInstruction* instruction,
+                              const Graph* graph,
+                              const struct LogBook* logBook);
+static bool Filter_Compare(long long lhs, int compare, long long rhs);
+static void Filter_TrimLastWord(Bitset* bitset);
+
+Filter Filter_Init() {
+  Filter this = {
+      .programSize = 0,
+      .strings = "",
+      .stringsSize = 0,
+      .error = "",
+      .visibleSize = 0,
+  };
+  for (size_t i = 0; i < FILTER_PROGRAM_SIZE; ++i) {
+    this.program[i].matches = Bitset_Init();
+  }
+  for (size_t i = 0; i < FILTER_STACK_SIZE; ++i) {
+    this.stack[i] = Bitset_Init();
+  }
+  return this;
+}
+
+void Filter_Destroy(Filter* this) {
+  for (size_t i = 0; i < FILTER_PROGRAM_SIZE; ++i) {
+    Bitset_Destroy(&this->program[i].matches);
+  }
+  for (size_t i = 0; i < FILTER_STACK_SIZE; ++i) {
+    Bitset_Destroy(&this->stack[i]);
+  }
+  *this = Filter_Init();
+}
+
+// Empty text compiles to filter letting every node through. On syntax error filter is inactive and error describes it.
+bool Filter_Compile(Filter* this, const char* text) {
+  Filter_Destroy(this);
+  FilterParser parser = {.filter = this, .text = text, .at = text, .depth = 0};
+  Filter_Accept(&parser, "");
+  if (*parser.at == '\0') {
+    return true;
+  }
+  if (!Filter_ParseOr(&parser)) {
+    return false;
+  }
+  if (*parser.at != '\0') {
+    return Filter_Fail(&parser, "unexpected text");
+  }
+  return true;
+}
+
+bool Filter_IsActive(const Filter* this) {
+  return this->programSize > 0;
+}
+
+// Result has a bit for every node of graph, now is time of current snapshot which ages are counted to
+const Bitset* Filter_Evaluate(Filter* this, const Graph* graph, const struct LogBook* logBook, time_t now) {
+  const size_t wordsSize = (graph->nodesSize + 63) / 64;
+  size_t top = 0;
+  for (FilterInstruction* it = this->program; it < this->program + this->programSize; ++it) {
+    switch (it->op) {
+      case EFilterOp_And:
+        --top;
+        for (size_t w = 0; w < wordsSize; ++w) {
+          this->stack[top - 1].words[w] &= this->stack[top].words[w];
+        }
+        break;
+      case EFilterOp_Or:
+        --top;
+        for (size_t w = 0; w < wordsSize; ++w) {
+          this->stack[top - 1].words[w] |= this->stack[top].words[w];
+        }
+        break;
+      case EFilterOp_Not:
+        for (size_t w = 0; w < wordsSize; ++w) {
+          this->stack[top - 1].words[w] = ~this->stack[top - 1].words[w];
+        }
+        Filter_TrimLastWord(&this->stack[top - 1]);
+        break;
+      default:
+        Bitset_Resize(&this->stack[top], graph->nodesSize);
+        Filter_Test(this, it, graph, logBook, now, &this->stack[top]);
+        ++top;
+        break;
+    }
+  }
+  if (this->programSize == 0) {
+    Bitset_Resize(&this->stack[0], graph->nodesSize);
+    memset(this->stack[0].words, 0xff, wordsSize * sizeof(uint64_t));
+    Filter_TrimLastWord(&this->stack[0]);
+  }
+
+  this->visibleSize = 0;
+  for (size_t w = 0; w < wordsSize; ++w) {
+    this->visibleSize += __builtin_popcountll(this->stack[0].words[w]);
+  }
+  return &this->stack[0];
+}
+
+static bool Filter_ParseOr(FilterParser* parser) {
+  if (!Filter_ParseAnd(parser)) {
+    return false;
+  }
+  while (Filter_Accept(parser, "||")) {
+    if (!Filter_ParseAnd(parser) || !Filter_Emit(parser, (FilterInstruction){.op = EFilterOp_Or})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool Filter_ParseAnd(FilterParser* parser) {
+  if (!Filter_ParseUnary(parser)) {
+    return false;
+  }
+  while (Filter_Accept(parser, "&&")) {
+    if (!Filter_ParseUnary(parser) || !Filter_Emit(parser, (FilterInstruction){.op = EFilterOp_And})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool Filter_ParseUnary(FilterParser* parser) {
+  if (Filter_Accept(parser, "!")) {
+    return Filter_ParseUnary(parser) && Filter_Emit(parser, (FilterInstruction){.op = EFilterOp_Not});
+  }
+  if (Filter_Accept(parser, "(")) {
+    if (!Filter_ParseOr(parser)) {
+      return false;
+    }
+    return Filter_Accept(parser, ")") || Filter_Fail(parser, "expected )");
+  }
+  return Filter_ParseTerm(parser);
+}
+
+// status (==|!=) waiting|ongoing|finished, name (==|!=|~|!~) "text", age (==|!=|<|<=|>|>=) number[s|m|h|d]
+static bool Filter_ParseTerm(FilterParser* parser) {
+  char field[16];
+  if (Filter_ParseWord(parser, field, sizeof(field)) == 0) {
+    return Filter_Fail(parser, "expected status, name or age");
+  }
+  if (strcmp(field, "status") != 0 && strcmp(field, "name") != 0 && strcmp(field, "age") != 0) {
+    return Filter_Fail(parser, "unknown field");
+  }
+  FilterInstruction instruction = {.op = EFilterOp_Status};
+  if (!Filter_ParseCompare(parser, &instruction.compare)) {
+    return false;
+  }
+  if (strcmp(field, "status") == 0) {
+    if (instruction.compare != EFilterCompare_Equal && instruction.compare != EFilterCompare_NotEqual) {
+      return Filter_Fail(parser, "status takes == or !=");
+    }
+    char status[16];
+    Filter_ParseWord(parser, status, sizeof(status));
+    for (instruction.value = 0; instruction.value < EStatus_Size; ++instruction.value) {
+      if (strcmp(status, LogBook_StatusName(instruction.value)) == 0) {
+        return Filter_Emit(parser, instruction);
+      }
+    }
+    return Filter_Fail(parser, "expected waiting, ongoing or finished");
+  }
+  if (strcmp(field, "name") == 0) {
+    return Filter_ParseName(parser, &instruction) && Filter_Emit(parser, instruction);
+  }
+  return Filter_ParseAge(parser, &instruction) && Filter_Emit(parser, instruction);
+}
+
+static bool Filter_ParseCompare(FilterParser* parser, int* compare) {
+  // longer tokens first, so prefixes of them do not match instead
+  const struct {
+    const char* token;
+    int compare;
+  } compares[] = {
+      {"==", EFilterCompare_Equal},
+      {"!=", EFilterCompare_NotEqual},
+      {"<=", EFilterCompare_LessEqual},
+      {">=", EFilterCompare_GreaterEqual},
+      {"!~", EFilterCompare_NotContains},
+      {"=", EFilterCompare_Equal},
+      {"<", EFilterCompare_Less},
+      {">", EFilterCompare_Greater},
+      {"~", EFilterCompare_Contains},
+  };
+  for (size_t i = 0; i < sizeof(compares) / sizeof(compares[0]); ++i) {
+    if (Filter_Accept(parser, compares[i].token)) {
+      *compare = compares[i].compare;
+      return true;
+    }
+  }
+  return Filter_Fail(parser, "expected comparison");
+}
+
+// Quoted text or a single word, kept in strings of filter
+static bool Filter_ParseName(FilterParser* parser, FilterInstruction* instruction) {
+  instruction->op = EFilterOp_Name;
+  if (instruction->compare != EFilterCompare_Equal && instruction->compare != EFilterCompare_NotEqual &&
+      instruction->compare != EFilterCompare_Contains && instruction->compare != EFilterCompare_NotContains) {
+    return Filter_Fail(parser, "name takes ==, !=, ~ or !~");
+  }
+  Filter* filter = parser->filter;
+  char* text = filter->strings + filter->stringsSize;
+  const size_t available = FILTER_TEXT_SIZE - filter->stringsSize;
+  size_t length = 0;
+  if (*parser->at == '"') {
+    const char* end = strchr(parser->at + 1, '"');
+    if (end == NULL) {
+      return Filter_Fail(parser, "expected closing \"");
+    }
+    length = end - parser->at - 1;
+    if (length >= available) {
+      return Filter_Fail(parser, "text too long");
+    }
+    memcpy(text, parser->at + 1, length);
+    text[length] = '\0';
+    parser->at = end + 1;
+    Filter_Accept(parser, "");
+  } else {
+    length = Filter_ParseWord(parser, text, available);
+  }
+  if (length == 0) {
+    return Filter_Fail(parser, "expected text");
+  }
+  instruction->text = filter->stringsSize;
+  filter->stringsSize += length + 1;
+  return true;
+}
+
+static bool Filter_ParseAge(FilterParser* parser, FilterInstruction* instruction) {
+  instruction->op = EFilterOp_Age;
+  if (instruction->compare == EFilterCompare_Contains || instruction->compare == EFilterCompare_NotContains) {
+    return Filter_Fail(parser, "age takes ==, !=, <, <=, > or >=");
+  }
+  char* end = NULL;
+  instruction->value = strtoll(parser->at, &end, 10);
+  if (end == parser->at) {
+    return Filter_Fail(parser, "expected number of seconds");
+  }
+  parser->at = end;
+  const char* units = "smhd";
+  const long long seconds[] = {1, 60, 60 * 60, 24 * 60 * 60};
+  const char* unit = *parser->at ? strchr(units, *parser->at) : NULL;
+  if (unit) {
+    instruction->value *= seconds[unit - units];
+    ++parser->at;
+  }
+  Filter_Accept(parser, "");
+  return true;
+}
+
+static size_t Filter_ParseWord(FilterParser* parser, char* word, size_t size) {
+  size_t length = 0;
+  while (isalnum((unsigned char)parser->at[length]) || parser->at[length] == '_' || parser->at[length] == '-' ||
+         parser->at[length] == '.' || parser->at[length] == '/') {
+    ++length;
+  }
+  if (length >= size) {
+    length = 0;
+  }
+  memcpy(word, parser->at, length);
+  word[length] = '\0';
+  parser->at += length;
+  Filter_Accept(parser, "");
+  return length;
+}
+
+// Token is consumed together with whitespace after it, empty one skips whitespace only
+static bool Filter_Accept(FilterParser* parser, const char* token) {
+  const size_t length = strlen(token);
+  if (strncmp(parser->at, token, length) != 0) {
+    return false;
+  }
+  parser->at += length;
+  while (isspace((unsigned char)*parser->at)) {
+    ++parser->at;
+  }
+  return true;
+}
+
+static bool Filter_Emit(FilterParser* parser, FilterInstruction instruction) {
+  Filter* filter = parser->filter;
+  if (filter->programSize == FILTER_PROGRAM_SIZE) {
+    return Filter_Fail(parser, "expression too long");
+  }
+  if (instruction.op == EFilterOp_And || instruction.op == EFilterOp_Or) {
+    --parser->depth;
+  } else if (instruction.op != EFilterOp_Not && ++parser->depth > FILTER_STACK_SIZE) {
+    return Filter_Fail(parser, "expression nested too deep");
+  }
+  instruction.matches = Bitset_Init();
+  instruction.matchedSize = 0;
+  filter->program[filter->programSize++] = instruction;
+  return true;
+}
+
+static bool Filter_Fail(FilterParser* parser, const char* message) {
+  Filter* filter = parser->filter;
+  snprintf(filter->error, sizeof(filter->error), "%s at %zu", message, (size_t)(parser->at - parser->text) + 1);
+  filter->programSize = 0;
+  return false;
+}
+
+static void Filter_Test(Filter* this,
+                        FilterInstruction* instruction,
+                        const Graph* graph,
+                        const struct LogBook* logBook,
+                        time_t now,
+                        Bitset* result) {
+  const size_t wordsSize = (graph->nodesSize + 63) / 64;
+  if (instruction->op == EFilterOp_Name) {
+    Filter_MatchNames(this, instruction, graph, logBook);
+    const bool negated =
+        instruction->compare == EFilterCompare_NotEqual || instruction->compare == EFilterCompare_NotContains;
+    if (graph->idsSize == graph->nodesSize) {  // nothing dropped, so node ids are its indexes
+      for (size_t w = 0; w < wordsSize; ++w) {
+        result->words[w] = negated ? ~instruction->matches.words[w] : instruction->matches.words[w];
+      }
+    } else {
+      memset(result->words, 0, wordsSize * sizeof(uint64_t));
+      for (size_t i = 0; i < graph->nodesSize; ++i) {
+        if (Bitset_Test(&instruction->matches, graph->nodes[i].id) != negated) {
+          Bitset_Set(result, i);
+        }
+      }
+    }
+    Filter_TrimLastWord(result);
+    return;
+  }
+
+  for (size_t w = 0; w < wordsSize; ++w) {
+    const size_t end = (w + 1) * 64 < graph->nodesSize ? (w + 1) * 64 : graph->nodesSize;
+    uint64_t word = 0;
+    for (size_t i = w * 64; i < end; ++i) {
+      const Node* node = &graph->nodes[i];
+      const long long lhs = instruction->op == EFilterOp_Status ? (long long)node->status : now - node->timestamp;
+      word |= (uint64_t)Filter_Compare(lhs, instruction->compare, instruction->value) << (i % 64);
+    }
+    result->words[w] = word;
+  }
+}
+
+// Names of nodes not seen by previous evaluations only, matches are kept as capacity grows. Names are taken from
+// NodeStats, as node may have been dropped from graph already.
+static void Filter_MatchNames(const Filter* this,
+                              FilterInstruction* instruction,
+                              const Graph* graph,
+                              const struct LogBook* logBook) {
+  if (graph->idsSize <= instruction->matchedSize) {
+    return;
+  }
+  if (graph->idsSize > instruction->matches.size) {
+    Bitset grown = Bitset_Init();
+    Bitset_Resize(&grown, graph->idsSize * 2);
+    if (instruction->matches.words) {
+      memcpy(grown.words, instruction->matches.words, (instruction->matchedSize + 63) / 64 * sizeof(uint64_t));
+    }
+    Bitset_Destroy(&instruction->matches);
+    instruction->matches = grown;
+  }
+  const char* text = this->strings + instruction->text;
+  const bool whole = instruction->compare == EFilterCompare_Equal || instruction->compare == EFilterCompare_NotEqual;
+  for (size_t id = instruction->matchedSize; id < graph->idsSize; ++id) {
+    const char* name = LogBook_GetNodeName(logBook, logBook->stats.nodeNames[id]);
+    if (whole ? strcmp(name, text) == 0 : strstr(name, text) != NULL) {
+      Bitset_Set(&instruction->matches, id);
+    }
+  }
+  instruction->matchedSize = graph->idsSize;
+}
+
+static bool Filter_Compare(long long lhs, int compare, long long rhs) {
+  switch (compare) {  // clang-format off
+    case EFilterCompare_Equal: return lhs == rhs;
+    case EFilterCompare_NotEqual: return lhs != rhs;
+    case EFilterCompare_Less: return lhs < rhs;
+    case EFilterCompare_LessEqual: return lhs <= rhs;
+    case EFilterCompare_Greater: return lhs > rhs;
+    case EFilterCompare_GreaterEqual: return lhs >= rhs;
+    default: return false;
+  }  // clang-format on
+}
+
+// Bits past size are kept clear, so words can be counted and combined as they are
+static void Filter_TrimLastWord(Bitset* bitset) {
+  if (bitset->size % 64) {
+    bitset->words[bitset->size / 64] &= ~(uint64_t)0 >> (64 - bitset->size % 64);
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Bitset.h"
+#include "Graph.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#define FILTER_TEXT_SIZE 128
+#define FILTER_PROGRAM_SIZE 32
+#define FILTER_STACK_SIZE 8
+
+typedef enum {
+  EFilterOp_Status,
+  EFilterOp_Name,
+  EFilterOp_Age,
+  EFilterOp_And,
+  EFilterOp_Or,
+  EFilterOp_Not,
+} EFilterOp;
+
+typedef enum {
+  EFilterCompare_Equal,
+  EFilterCompare_NotEqual,
+  EFilterCompare_Less,
+  EFilterCompare_LessEqual,
+  EFilterCompare_Greater,
+  EFilterCompare_GreaterEqual,
+  EFilterCompare_Contains,
+  EFilterCompare_NotContains,
+} EFilterCompare;
+
+typedef struct FilterInstruction {
+  int op;
+  int compare;
+  long long value;  // status or seconds
+  size_t text;      // offset of name literal in Filter.strings
+  Bitset matches;   // names of nodes [0, matchedSize) matching, by Node.id
+  size_t matchedSize;
+} FilterInstruction;
+
+// Expression such as `status!=finished && name~"Wydobycie" && age>30s`, compiled to postfix program. Every
+// instruction is evaluated for all nodes at once, into a bitset on top of stack. Node of given id has the same name
+// in every snapshot of one log, so names are matched once per node; Filter_Compile starts over.
+typedef struct Filter {
+  FilterInstruction program[FILTER_PROGRAM_SIZE];
+  size_t programSize;  // 0 when every node is visible
+  char strings[FILTER_TEXT_SIZE];
+  size_t stringsSize;
+  char error[64];
+  Bitset stack[FILTER_STACK_SIZE];
+  size_t visibleSize;  // nodes in stack[0] after Filter_Evaluate
+} Filter;
+
+Filter Filter_Init();
+void Filter_Destroy(Filter* this);
+bool Filter_Compile(Filter* this, const char* text);
+bool Filter_IsActive(const Filter* this);
+const Bitset* Filter_Evaluate(Filter* this, const Graph* graph, const struct LogBook* logBook, time_t now);
@@ -0,0 +1,100 @@
+#include "Focus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void Focus_Expand(Focus* this, const Graph* graph, size_t centre, size_t hops, int direction);
+static bool Focus_Visit(Focus* this, size_t node, int hops);
+static void* Focus_Alloc(size_t count, size_t size);
+
+Focus Focus_Init() {
+  return (Focus){
+      .nodesSize = 0,
+      .dependents = {.starts = NULL, .nodes = NULL},
+      .visible = Bitset_Init(),
+      .hops = NULL,
+      .frontier = Bitset_Init(),
+      .next = Bitset_Init(),
+  };
+}
+
+void Focus_Destroy(Focus* this) {
+  Graph_DestroyDependents(&this->dependents);
+  free(this->hops);
+  Bitset_Destroy(&this->visible);
+  Bitset_Destroy(&this->frontier);
+  Bitset_Destroy(&this->next);
+  *this = Focus_Init();
+}
+
+// Reverse adjacency is built once per graph, so that changing selection costs only the walk itself
+void Focus_Index(Focus* this, const Graph* graph) {
+  Graph_DestroyDependents(&this->dependents);
+  free(this->hops);
+  this->nodesSize = graph->nodesSize;
+  this->dependents = Graph_Dependents(graph);
+  this->hops = Focus_Alloc(graph->nodesSize, sizeof(int));
+
+  Bitset_Resize(&this->visible, graph->nodesSize);
+  Bitset_Resize(&this->frontier, graph->nodesSize);
+  Bitset_Resize(&this->next, graph->nodesSize);
+}
+
+void Focus_Compute(Focus* this, const Graph* graph, size_t centre, size_t hops) {
+  Bitset_Clear(&this->visible);
+  if (centre >= this->nodesSize) {
+    return;
+  }
+  hops = hops > FOCUS_MAX_HOPS ? FOCUS_MAX_HOPS : hops;
+  Bitset_Set(&this->visible, centre);
+  this->hops[centre] = 0;
+  Focus_Expand(this, graph, centre, hops, -1);
+  Focus_Expand(this, graph, centre, hops, 1);
+}
+
+// Breadth first walk, one frontier bitset per hop
+static void Focus_Expand(Focus* this, const Graph* graph, size_t centre, size_t hops, int direction) {
+  Bitset_Clear(&this->frontier);
+  Bitset_Set(&this->frontier, centre);
+  for (size_t hop = 1; hop <= hops; ++hop) {
+    Bitset_Clear(&this->next);
+    bool any = false;
+    for (size_t i = Bitset_Next(&this->frontier, 0); i < this->nodesSize; i = Bitset_Next(&this->frontier, i + 1)) {
+      if (direction < 0) {
+        for (const size_t* it = graph->nodes[i].dependencies; *it != (size_t)-1; ++it) {
+          any |= Focus_Visit(this, *it, -(int)hop);
+        }
+      } else {
+        const size_t* end = this->dependents.nodes + this->dependents.starts[i + 1];
+        for (const size_t* it = this->dependents.nodes + this->dependents.starts[i]; it < end; ++it) {
+          any |= Focus_Visit(this, *it, (int)hop);
+        }
+      }
+    }
+    if (!any) {
+      break;
+    }
+    const Bitset swap = this->frontier;
+    this->frontier = this->next;
+    this->next = swap;
+  }
+}
+
+static bool Focus_Visit(Focus* this, size_t node, int hops) {
+  if (Bitset_Test(&this->visible, node)) {
+    return false;
+  }
+  Bitset_Set(&this->visible, node);
+  Bitset_Set(&this->next, node);
+  this->hops[node] = hops;
+  return true;
+}
+
+static void* Focus_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for Focus");
+    exit(10);
+  }
+  return memory;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Bitset.h"
+#include "Graph.h"
+
+#include <stddef.h>
+
+#define FOCUS_MAX_HOPS 8
+
+// Neighbourhood of selected node: its dependencies and dependents up to given number of hops away
+typedef struct Focus {
+  size_t nodesSize;  // of graph dependents were built for
+  Dependents dependents;
+  Bitset visible;  // members of neighbourhood, valid after Focus_Compute
+  int* hops;       // signed distance of member from centre, negative upstream, positive downstream
+  Bitset frontier;
+  Bitset next;
+} Focus;
+
+Focus Focus_Init();
+void Focus_Destroy(Focus* this);
+void Focus_Index(Focus* this, const Graph* graph);
+void Focus_Compute(Focus* this, const Graph* graph, size_t centre, size_t hops);
@@ -1,28 +1,75 @@
 #include "FrameList.h"
+#include "Profiler.h"
 
 #include <raygui.h>
+#include <math.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <time.h>
 
+#define FRAMELIST_MAP_H 56
+#define FRAMELIST_MAP_MAX_W 512
 
-void FrameList_Draw(const Rectangle rect, size_t* currentLog, bool* refreshNeeded, const LogBook* logBook) {
+static void FrameList_FormatLabel(char* label, size_t labelSize, const LogEntry* entry);
+static void FrameList_DrawMap(FrameList* this,
+                              const Rectangle rect,
+                              size_t* currentLog,
+                              bool* refreshNeeded,
+                              const LogBook* logBook);
+static void FrameList_HandleMapWheel(FrameList* this, const Rectangle rect, const ActivityMap* map);
+
+FrameList FrameList_Init() {
+  return (FrameList){
+      .scrollOffset = {0, 0},
+      .visibleRect = {0, 0, 0, 0},
+      .centeredEntry = (size_t)-1,
+      .mapFrom = 0,
+      .mapSeconds = 0,
+      .mapDragging = false,
+  };
+}
+
+void FrameList_CenterOn(FrameList* this, size_t entry) {
+  this->centeredEntry = entry;
+}
+
+// Activity map on top, list of entries below
+void FrameList_Draw(FrameList* this,
+                    const Rectangle bounds,
+                    size_t* currentLog,
+                    bool* refreshNeeded,
+                    const LogBook* logBook) {
+  PROFILER_SCOPE(EPhase_DrawFrameList);
   const float CHAR_SIZE = 14;  // TODO: placeholder - should be taken from theme parameters
-  static Vector2 offsetVec = {0, 0};
-  static struct Rectangle visibleRect = {0, 0, 0, 0};
+  FrameList_DrawMap(this, (Rectangle){bounds.x, bounds.y, bounds.width, FRAMELIST_MAP_H}, currentLog, refreshNeeded,
+                    logBook);
+  const float MAP_SPACE = FRAMELIST_MAP_H + 4;
+  const Rectangle rect = {bounds.x, bounds.y + MAP_SPACE, bounds.width, bounds.height - MAP_SPACE};
+  if (this->centeredEntry != (size_t)-1) {
+    this->scrollOffset.y = this->visibleRect.height / 2 - CHAR_SIZE * (this->centeredEntry + 0.5);
+    this->scrollOffset.y = this->scrollOffset.y > 0 ? 0 : this->scrollOffset.y;
+    this->centeredEntry = (size_t)-1;
+  }
   GuiScrollPanel(rect, NULL,
                  (Rectangle){.x = 0, .y = 0, .width = rect.width - 15, .height = logBook->entriesSize * CHAR_SIZE},
-                 &offsetVec, &visibleRect);
-  BeginScissorMode(visibleRect.x, visibleRect.y, visibleRect.width, visibleRect.height);
-  for (int i = 0; i < logBook->entriesSize; ++i) {
+                 &this->scrollOffset, &this->visibleRect);
+
+  // only rows intersecting visibleRect are formatted and drawn
+  const float firstRow = -this->scrollOffset.y / CHAR_SIZE;
+  size_t first = firstRow > 0 ? (size_t)firstRow : 0;
+  size_t last = (size_t)((-this->scrollOffset.y + this->visibleRect.height) / CHAR_SIZE) + 1;
+  last = last > logBook->entriesSize ? logBook->entriesSize : last;
+
+  BeginScissorMode(this->visibleRect.x, this->visibleRect.y, this->visibleRect.width, this->visibleRect.height);
+  for (size_t i = first; i < last; ++i) {
     char label[32];
-    struct tm* timeInfo = gmtime(&logBook->entries[i].timestamp);
-    strftime(label, 32, "%H:%M:%S %d-%m-%Y", timeInfo);
+    FrameList_FormatLabel(label, sizeof(label), &logBook->entries[i]);
     if (*currentLog == i) {
       GuiSetState(STATE_PRESSED);
     }
 
-    if (GuiLabelButton((Rectangle){visibleRect.x, visibleRect.y + CHAR_SIZE * i + offsetVec.y, rect.width, CHAR_SIZE},
+    if (GuiLabelButton((Rectangle){this->visibleRect.x, this->visibleRect.y + CHAR_SIZE * i + this->scrollOffset.y,
+                                   rect.width, CHAR_SIZE},
                        label)) {
       *currentLog = i;
       *refreshNeeded = true;
@@ -31,3 +78,120 @@ void FrameList_Draw(const Rectangle rect, size_t* currentLog, bool* refreshNeede
   }
   EndScissorMode();
 }
+
+// Entries per pixel stacked by operation, with line of ongoing nodes. Click or drag seeks, Ctrl + wheel zooms time
+// and wheel alone pans zoomed map.
+static void FrameList_DrawMap(FrameList* this,
+                              const Rectangle rect,
+                              size_t* currentLog,
+                              bool* refreshNeeded,
+                              const LogBook* logBook) {
+  const ActivityMap* map = &logBook->activity;
+  DrawRectangleLinesEx(rect, 1, GetColor(GuiGetStyle(DEFAULT, BORDER_COLOR_NORMAL)));
+  if (logBook->entriesSize == 0 || map->levelsSize == 0) {
+    return;
+  }
+  const double span = map->end - map->begin + 1;
+  if (this->mapSeconds >= span || this->mapFrom < map->begin || this->mapFrom + this->mapSeconds > map->begin + span) {
+    this->mapSeconds = 0;  // another log has been loaded
+  }
+  FrameList_HandleMapWheel(this, rect, map);
+
+  const double seconds = this->mapSeconds > 0 ? this->mapSeconds : span;
+  const double from = this->mapSeconds > 0 ? this->mapFrom : map->begin;
+  const Rectangle area = {rect.x + 1, rect.y + 1, rect.width - 2, rect.height - 2};
+  const size_t width = area.width < FRAMELIST_MAP_MAX_W ? (size_t)area.width : FRAMELIST_MAP_MAX_W;
+  if (width == 0) {
+    return;
+  }
+  const double secondsPerPixel = seconds / width;
+  ActivityBucket pixels[FRAMELIST_MAP_MAX_W];
+  ActivityMap_Resample(map, from, secondsPerPixel, pixels, width);
+
+  uint32_t maxCount = 1;
+  uint32_t maxOngoing = 1;
+  for (size_t p = 0; p < width; ++p) {
+    uint32_t count = 0;
+    for (size_t op = 0; op < ACTIVITYMAP_OPERATIONS; ++op) {
+      count += pixels[p].counts[op];
+    }
+    maxCount = count > maxCount ? count : maxCount;
+    maxOngoing = pixels[p].ongoing > maxOngoing ? pixels[p].ongoing : maxOngoing;
+  }
+
+  // dependency changes share one colour
+  const struct {
+    EOperation operation;
+    Color color;
+  } SERIES[] = {
+      {EOperation_Add, GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_FOCUSED))},
+      {EOperation_StatusChange, GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_NORMAL))},
+      {EOperation_AddDependency, GetColor(GuiGetStyle(DEFAULT, LINE_COLOR))},
+      {EOperation_RemoveDependency, GetColor(GuiGetStyle(DEFAULT, LINE_COLOR))},
+      {EOperation_Remove, GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_DISABLED))},
+  };
+  Vector2 ongoing[FRAMELIST_MAP_MAX_W];
+  for (size_t p = 0; p < width; ++p) {
+    float bottom = area.y + area.height;
+    for (size_t s = 0; s < sizeof(SERIES) / sizeof(SERIES[0]); ++s) {
+      const float h = area.height * pixels[p].counts[SERIES[s].operation] / maxCount;
+      DrawRectangleRec((Rectangle){area.x + p, bottom - h, 1, h}, SERIES[s].color);
+      bottom -= h;
+    }
+    ongoing[p] = (Vector2){area.x + p + 0.5, area.y + area.height * (1 - (float)pixels[p].ongoing / maxOngoing)};
+  }
+  DrawLineStrip(ongoing, width, GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_PRESSED)));
+
+  const float currentX = area.x + (logBook->entries[*currentLog].timestamp - from) / secondsPerPixel;
+  if (currentX >= area.x && currentX < area.x + width) {
+    DrawLine(currentX, area.y, currentX, area.y + area.height, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_NORMAL)));
+  }
+
+  const Vector2 mouse = GetMousePosition();
+  if (!GuiIsLocked() && GuiGetState() != STATE_DISABLED && IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
+      CheckCollisionPointRec(mouse, area)) {
+    this->mapDragging = true;
+  }
+  if (this->mapDragging && !IsMouseButtonDown(MOUSE_BUTTON_LEFT)) {
+    this->mapDragging = false;
+  }
+  if (this->mapDragging) {
+    const float x = fminf(fmaxf(mouse.x, area.x), area.x + width);
+    size_t entry = LogBook_FindEntry(logBook, floor(from + (x - area.x) * secondsPerPixel));
+    entry = entry == (size_t)-1 ? 0 : entry;
+    if (entry != *currentLog) {
+      *currentLog = entry;
+      *refreshNeeded = true;
+      this->centeredEntry = entry;
+    }
+  }
+}
+
+// Time under cursor stays in place while zooming, zoom stops at few buckets of the finest level
+static void FrameList_HandleMapWheel(FrameList* this, const Rectangle rect, const ActivityMap* map) {
+  const Vector2 mouse = GetMousePosition();
+  const float wheel = GetMouseWheelMove();
+  if (wheel == 0 || GuiIsLocked() || GuiGetState() == STATE_DISABLED || !CheckCollisionPointRec(mouse, rect)) {
+    return;
+  }
+  const double span = map->end - map->begin + 1;
+  double seconds = this->mapSeconds > 0 ? this->mapSeconds : span;
+  double from = this->mapSeconds > 0 ? this->mapFrom : map->begin;
+  if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) {
+    const double anchor = from + seconds * (mouse.x - rect.x) / rect.width;
+    const double minSeconds = fmin(span, 8.0 * map->bucketSeconds);
+    seconds = fmin(fmax(seconds * pow(0.8, wheel), minSeconds), span);
+    from = anchor - seconds * (mouse.x - rect.x) / rect.width;
+  } else {
+    from -= wheel * seconds / 8;
+  }
+  from = fmin(fmax(from, map->begin), map->begin + span - seconds);
+  this->mapFrom = from;
+  this->mapSeconds = seconds < span ? seconds : 0;
+}
+
+static void FrameList_FormatLabel(char* label, size_t labelSize, const LogEntry* entry) {
+  struct tm timeInfo;
+  gmtime_r(&entry->timestamp, &timeInfo);
+  strftime(label, labelSize, "%H:%M:%S %d-%m-%Y", &timeInfo);
+}
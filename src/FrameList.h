@@ -4,5 +4,19 @@
 
 #include <raylib.h>
 
-void FrameList_Draw(const Rectangle rect, size_t* currentLog, bool* refreshNeeded, const LogBook* logBook);
+typedef struct FrameList {
+  Vector2 scrollOffset;
+  Rectangle visibleRect;
+  size_t centeredEntry;  // entry to be centered on next draw, (size_t)-1 if none
+  double mapFrom;        // time range of activity map, whole log when mapSeconds is 0
+  double mapSeconds;
+  bool mapDragging;
+} FrameList;
 
+FrameList FrameList_Init();
+void FrameList_CenterOn(FrameList* this, size_t entry);
+void FrameList_Draw(FrameList* this,
+                    const Rectangle rect,
+                    size_t* currentLog,
+                    bool* refreshNeeded,
+                    const LogBook* logBook);
@@ -7,171 +7,357 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define GRAPH_DROPPED ((size_t)-1)  // nodeName of node about to be dropped
+
 static Node* Graph_FindNode(Graph const* graph, size_t nodeName);
+static Node* Graph_FindLogNode(Graph const* graph, const struct LogBook* logBook, const LogEntry* log);
 static Edge* Graph_FindEdge(Graph const* graph, size_t source, size_t destination);
+static void Graph_PushEdge(Graph* this, size_t source, size_t destination);
+static void Graph_Finish(Graph* this, Node* node, size_t entry, time_t timestamp);
+static void Graph_DropExpired(Graph* this, size_t entry, time_t timestamp);
+static void Graph_Compact(Graph* this, size_t droppedSize);
+static void* Graph_Grow(void* items, size_t* capacity, size_t itemSize);
 
 void Graph_Destroy(Graph* this) {
   free(this->edges);
   this->edgesSize = 0;
+  this->edgesCapacity = 0;
   free(this->coordinates);
   free(this->nodes);
   this->nodesSize = 0;
+  this->nodesCapacity = 0;
+  free(this->slotOfId);
+  this->slotOfId = NULL;
+  free(this->finished);
+  this->finished = NULL;
+  this->finishedBegin = 0;
+  this->finishedSize = 0;
+  this->finishedCapacity = 0;
 }
 
 Graph Graph_Init(const struct LogBook* logBook, size_t currentLogIndex) {
+  return Graph_InitRetaining(logBook, currentLogIndex, (Retention){.entries = 0, .seconds = 0});
+}
+
+Graph Graph_InitRetaining(const struct LogBook* logBook, size_t currentLogIndex, Retention retention) {
+  Graph this = Graph_Make(logBook);
+  Graph_SetRetention(&this, retention);
+  if (!logBook) {
+    return this;
+  }
+
+  if (currentLogIndex >= logBook->entriesSize) {
+    puts("Runtime error: currentLogIndex > logBook.entriesSize");
+    exit(10);
+  }
+
+  const LogEntry* logEnd = logBook->entries + currentLogIndex + 1;
+  for (const LogEntry* log = logBook->entries; log < logEnd; ++log) {
+    Graph_Apply(&this, logBook, log);
+  }
+  return this;
+}
+
+// Empty graph ready for Graph_Apply, nodes are allocated as they are added
+Graph Graph_Make(const struct LogBook* logBook) {
   Graph this = {
       .nodes = NULL,
       .nodesSize = 0,
+      .nodesCapacity = 0,
       .coordinates = NULL,
       .edges = NULL,
       .edgesSize = 0,
+      .edgesCapacity = 0,
+      .statusCounts = {0},
+      .slotOfId = NULL,
+      .idsSize = 0,
+      .retention = {.entries = 0, .seconds = 0},
+      .finished = NULL,
+      .finishedBegin = 0,
+      .finishedSize = 0,
+      .finishedCapacity = 0,
+      .droppedSize = 0,
   };
 
   if (!logBook) {
     return this;
   }
 
-  if (currentLogIndex >= logBook->entriesSize) {
-    puts("Runtime error: currentLogIndex > logBook.entriesSize");
+  const size_t maxNodesNumber = DynamicArray_Size(size_t, logBook->nodeNames.offsets);
+  this.coordinates = calloc(maxNodesNumber, sizeof(Vector2));
+  this.slotOfId = malloc((maxNodesNumber ? maxNodesNumber : 1) * sizeof(size_t));
+  if (maxNodesNumber > 0 && (this.coordinates == NULL || this.slotOfId == NULL)) {
+    perror("Cannot calloc memory for Graph");
     exit(10);
   }
+  return this;
+}
 
-  const size_t maxNodesNumber = DynamicArray_Size(size_t, logBook->nodeNames.offsets);
-  this.nodes = calloc(maxNodesNumber, sizeof(Node));
-  this.coordinates = calloc(maxNodesNumber, sizeof(Node));
-  this.edges = calloc(maxNodesNumber * (maxNodesNumber - 1), sizeof(Edge));
-  printf("calloc(%ld, %ld) : %p \n", maxNodesNumber, sizeof(Node), (void*)this.nodes);
-
-  LogEntry* logBegin = logBook->entries;
-  LogEntry* logEnd = logBegin + currentLogIndex + 1;
-  for (LogEntry* log = logBegin; log < logEnd; ++log) {
-    switch (log->operation) {
-      case EOperation_Add: {
-        if (this.nodesSize >= maxNodesNumber) {
-          perror("More nodes than expected");
-          exit(10);
-        }
-        Node* node = &this.nodes[this.nodesSize++];
-        node->timestamp = log->timestamp;
-        node->nodeName = log->nodeName;
-        node->status = log->status;
-
-        size_t i = 0;
-        while (log->dependencies[i] != 0) {
-          node->dependencies[i] = Graph_FindNode(&this, log->dependencies[i]) - this.nodes;
-          ++i;
-        }
-        node->dependencies[i] = (size_t)-1;
-
-        i = 0;
-        while (node->dependencies[i] != (size_t)-1) {
-          Edge* e = &this.edges[this.edgesSize++];
-          e->destination = node - this.nodes;
-          e->source = node->dependencies[i];
-          ++i;
+// Has to be set before first Graph_Apply
+void Graph_SetRetention(Graph* this, Retention retention) {
+  this->retention = retention;
+}
+
+bool Graph_Retains(const Graph* this) {
+  return this->retention.entries > 0 || this->retention.seconds > 0;
+}
+
+// Number of entries, or number of seconds with s, m, h or d unit
+bool Graph_ParseRetention(const char* text, Retention* retention) {
+  char* end = NULL;
+  const long long value = strtoll(text, &end, 10);
+  if (end == text || value <= 0) {
+    return false;
+  }
+  *retention = (Retention){.entries = 0, .seconds = 0};
+  const char* units = "smhd";
+  const time_t seconds[] = {1, 60, 60 * 60, 24 * 60 * 60};
+  if (*end == '\0') {
+    retention->entries = value;
+    return true;
+  }
+  const char* unit = strchr(units, *end);
+  if (unit == NULL || end[1] != '\0') {
+    return false;
+  }
+  retention->seconds = value * seconds[unit - units];
+  return true;
+}
+
+void Graph_Apply(Graph* this, const struct LogBook* logBook, const LogEntry* log) {
+  const size_t entry = log - logBook->entries;
+  switch (log->operation) {
+    case EOperation_Add: {
+      if (this->idsSize >= DynamicArray_Size(size_t, logBook->nodeNames.offsets)) {
+        perror("More nodes than expected");
+        exit(10);
+      }
+      if (this->nodesSize == this->nodesCapacity) {
+        this->nodes = Graph_Grow(this->nodes, &this->nodesCapacity, sizeof(Node));
+      }
+      Node* node = &this->nodes[this->nodesSize++];
+      node->timestamp = log->timestamp;
+      node->nodeName = log->nodeName;
+      node->status = log->status;
+      node->id = this->idsSize++;
+      this->slotOfId[node->id] = node - this->nodes;
+      ++this->statusCounts[node->status];
+      if (node->status == EStatus_Finished) {
+        Graph_Finish(this, node, entry, log->timestamp);
+      }
+
+      // dependencies already dropped are finished, so they do not block node any more
+      size_t i = 0;
+      for (const size_t* dependency = log->dependencies; *dependency != 0; ++dependency) {
+        const Node* found = Graph_FindNode(this, *dependency);
+        if (found) {
+          node->dependencies[i++] = found - this->nodes;
         }
+      }
+      node->dependencies[i] = (size_t)-1;
+
+      i = 0;
+      while (node->dependencies[i] != (size_t)-1) {
+        Graph_PushEdge(this, node->dependencies[i], node - this->nodes);
+        ++i;
+      }
+      break;
+    }
+
+    case EOperation_Remove: {
+      Node* node = Graph_FindLogNode(this, logBook, log);
+      if (node == NULL) {
         break;
       }
+      --this->statusCounts[node->status];
+      node->status = EStatus_Finished;
+      ++this->statusCounts[node->status];
+      Graph_Finish(this, node, entry, log->timestamp);
+      break;
+    }
 
-      case EOperation_Remove: {
-        Node* node = Graph_FindNode(&this, log->nodeName);
-        if (node == NULL) {
-          fprintf(stderr, "Unable to find node '%s' at log %ld", LogBook_GetNodeName(logBook, log->nodeName),
-                  log->timestamp);
-          exit(10);
-        }
-        node->status = EStatus_Finished;
+    case EOperation_StatusChange: {
+      Node* node = Graph_FindLogNode(this, logBook, log);
+      if (node == NULL) {
         break;
       }
+      --this->statusCounts[node->status];
+      node->status = log->status;
+      ++this->statusCounts[node->status];
+      if (node->status == EStatus_Finished) {
+        Graph_Finish(this, node, entry, log->timestamp);
+      }
+      break;
+    }
 
-      case EOperation_StatusChange: {
-        Node* node = Graph_FindNode(&this, log->nodeName);
-        if (node == NULL) {
-          fprintf(stderr, "Unable to find node '%s' at log %ld", LogBook_GetNodeName(logBook, log->nodeName),
-                  log->timestamp);
-          exit(10);
-        }
-        node->status = log->status;
+    case EOperation_AddDependency: {
+      Node* node = Graph_FindLogNode(this, logBook, log);
+      if (node == NULL) {
         break;
       }
 
-      case EOperation_AddDependency: {
-        Node* node = Graph_FindNode(&this, log->nodeName);
-        if (node == NULL) {
-          fprintf(stderr, "Unable to find node '%s' at log %ld", LogBook_GetNodeName(logBook, log->nodeName),
-                  log->timestamp);
-          exit(10);
-        }
+      size_t* nodeDepsEnd = node->dependencies;
+      while (*nodeDepsEnd != (size_t)-1) {
+        ++nodeDepsEnd;
+      }
 
-        size_t* nodeDepsEnd = node->dependencies;
-        while (*nodeDepsEnd != (size_t)-1) {
-          ++nodeDepsEnd;
+      for (size_t i = 0; log->dependencies[i] != 0; ++i) {
+        const Node* dependency = Graph_FindNode(this, log->dependencies[i]);
+        if (dependency == NULL) {
+          continue;
         }
+        size_t dependencyIndex = dependency - this->nodes;
+        *nodeDepsEnd = dependencyIndex;
+        ++nodeDepsEnd;
 
-        for (size_t i = 0; log->dependencies[i] != 0; ++i) {
-          size_t dependencyIndex = Graph_FindNode(&this, log->dependencies[i]) - this.nodes;
-          if (node == NULL) {
-            fprintf(stderr, "Unable to find node '%s' at log %ld", LogBook_GetNodeName(logBook, dependencyIndex),
-                    log->timestamp);
-            exit(10);
-          }
-          *nodeDepsEnd = dependencyIndex;
-          ++nodeDepsEnd;
+        Graph_PushEdge(this, dependencyIndex, node - this->nodes);
+      }
+      *nodeDepsEnd = (size_t)-1;
+      break;
+    }
 
-          Edge* e = &this.edges[this.edgesSize++];
-          e->destination = node - this.nodes;
-          e->source = dependencyIndex;
-        }
-        *nodeDepsEnd = (size_t)-1;
+    case EOperation_RemoveDependency: {
+      Node* node = Graph_FindLogNode(this, logBook, log);
+      if (node == NULL) {
         break;
       }
 
-      case EOperation_RemoveDependency: {
-        Node* node = Graph_FindNode(&this, log->nodeName);
-        if (node == NULL) {
-          fprintf(stderr, "Unable to find node '%s' at log %ld", LogBook_GetNodeName(logBook, log->nodeName),
-                  log->timestamp);
-          exit(10);
-        }
+      size_t* nodeDependenciesLast = node->dependencies;
+      while (*nodeDependenciesLast != (size_t)-1) {
+        ++nodeDependenciesLast;
+      }
+      --nodeDependenciesLast;
 
-        size_t* nodeDependenciesLast = node->dependencies;
-        while (*nodeDependenciesLast != (size_t)-1) {
-          ++nodeDependenciesLast;
+      for (const size_t* logDep = log->dependencies; *logDep != 0; ++logDep) {
+        const Node* logDependency = Graph_FindNode(this, *logDep);
+        if (logDependency == NULL) {
+          continue;
         }
-        --nodeDependenciesLast;
-
-        for (const size_t* logDep = log->dependencies; *logDep != 0; ++logDep) {
-          size_t logDependencyIndex = Graph_FindNode(&this, *logDep) - this.nodes;
-          size_t* nodeDependencyIndex = node->dependencies;
-          while (*nodeDependencyIndex != (size_t)-1) {
-            if (*nodeDependencyIndex == logDependencyIndex) {
-              *nodeDependencyIndex = *nodeDependenciesLast;
-              *nodeDependenciesLast = (size_t)-1;
-              --nodeDependenciesLast;
-              Edge* unwantedEdge = Graph_FindEdge(&this, logDependencyIndex, node - this.nodes);
-              *unwantedEdge = this.edges[--this.edgesSize];
-            } else {
-              ++nodeDependencyIndex;
-            }
+        size_t logDependencyIndex = logDependency - this->nodes;
+        size_t* nodeDependencyIndex = node->dependencies;
+        while (*nodeDependencyIndex != (size_t)-1) {
+          if (*nodeDependencyIndex == logDependencyIndex) {
+            *nodeDependencyIndex = *nodeDependenciesLast;
+            *nodeDependenciesLast = (size_t)-1;
+            --nodeDependenciesLast;
+            Edge* unwantedEdge = Graph_FindEdge(this, logDependencyIndex, node - this->nodes);
+            *unwantedEdge = this->edges[--this->edgesSize];
+          } else {
+            ++nodeDependencyIndex;
           }
         }
-        break;
       }
-      default:
-        break;
+      break;
     }
+    default:
+      break;
+  }
+  if (Graph_Retains(this)) {
+    Graph_DropExpired(this, entry, log->timestamp);
   }
-  return this;
 }
 
 void Graph_Copy(Graph* target, const Graph* source) {
   memcpy(target, source, sizeof(Graph));
   target->nodes = calloc(sizeof(Node), target->nodesSize);
-  memcpy(target->nodes, source->nodes, sizeof(Node) * target->nodesSize);
+  if (target->nodesSize > 0) {
+    memcpy(target->nodes, source->nodes, sizeof(Node) * target->nodesSize);
+  }
   target->coordinates = calloc(sizeof(Vector2), target->nodesSize);
   memcpy(target->coordinates, source->coordinates, sizeof(Vector2) * target->nodesSize);
+  target->edgesCapacity = target->edgesSize;
   target->edges = calloc(sizeof(Edge), target->edgesSize);
   memcpy(target->edges, source->edges, sizeof(Edge) * target->edgesSize);
+  target->nodesCapacity = target->nodesSize;
+  target->slotOfId = calloc(sizeof(size_t), target->idsSize);
+  if (target->idsSize > 0) {
+    memcpy(target->slotOfId, source->slotOfId, sizeof(size_t) * target->idsSize);
+  }
+  target->finishedBegin = 0;
+  target->finishedSize = source->finishedSize - source->finishedBegin;
+  target->finishedCapacity = target->finishedSize;
+  target->finished = calloc(sizeof(FinishedNode), target->finishedSize);
+  if (target->finishedSize > 0) {
+    memcpy(target->finished, source->finished + source->finishedBegin, sizeof(FinishedNode) * target->finishedSize);
+  }
+}
+
+// Index of node with given name in Graph.nodes, (size_t)-1 when graph does not contain it
+size_t Graph_NodeIndex(const Graph* this, size_t nodeName) {
+  const Node* node = Graph_FindNode(this, nodeName);
+  return node ? (size_t)(node - this->nodes) : (size_t)-1;
+}
+
+// Index in Graph.nodes of node with given id, which differ once finished nodes are dropped. (size_t)-1 when graph
+// does not contain it.
+size_t Graph_NodeOfId(const Graph* this, size_t id) {
+  return id < this->idsSize ? this->slotOfId[id] : (size_t)-1;
+}
+
+Dependents Graph_Dependents(const Graph* this) {
+  Dependents dependents = {
+      .starts = calloc(this->nodesSize + 1, sizeof(size_t)),
+      .nodes = calloc(this->edgesSize ? this->edgesSize : 1, sizeof(size_t)),
+  };
+  size_t* cursor = calloc(this->nodesSize ? this->nodesSize : 1, sizeof(size_t));
+  if (dependents.starts == NULL || dependents.nodes == NULL || cursor == NULL) {
+    perror("Cannot calloc memory for Graph dependents");
+    exit(10);
+  }
+  // counting sort of edges by source
+  for (const Edge* edge = this->edges; edge < this->edges + this->edgesSize; ++edge) {
+    ++dependents.starts[edge->source + 1];
+  }
+  for (size_t i = 0; i < this->nodesSize; ++i) {
+    dependents.starts[i + 1] += dependents.starts[i];
+  }
+  for (const Edge* edge = this->edges; edge < this->edges + this->edgesSize; ++edge) {
+    dependents.nodes[dependents.starts[edge->source] + cursor[edge->source]++] = edge->destination;
+  }
+  free(cursor);
+  return dependents;
+}
+
+void Graph_DestroyDependents(Dependents* dependents) {
+  free(dependents->starts);
+  dependents->starts = NULL;
+  free(dependents->nodes);
+  dependents->nodes = NULL;
+}
+
+// Kahn's algorithm. All nodes are put into order, but only returned number of them is sorted, the rest lies on
+// cycles or depends on them.
+size_t Graph_TopologicalOrder(const Graph* this, const Dependents* dependents, size_t* order) {
+  size_t* inDegree = calloc(this->nodesSize ? this->nodesSize : 1, sizeof(size_t));
+  if (inDegree == NULL) {
+    perror("Cannot calloc memory for Graph order");
+    exit(10);
+  }
+  for (const Edge* edge = this->edges; edge < this->edges + this->edgesSize; ++edge) {
+    ++inDegree[edge->destination];
+  }
+  size_t orderSize = 0;
+  for (size_t i = 0; i < this->nodesSize; ++i) {
+    if (inDegree[i] == 0) {
+      order[orderSize++] = i;
+    }
+  }
+  for (size_t head = 0; head < orderSize; ++head) {
+    const size_t node = order[head];
+    for (size_t j = dependents->starts[node]; j < dependents->starts[node + 1]; ++j) {
+      if (--inDegree[dependents->nodes[j]] == 0) {
+        order[orderSize++] = dependents->nodes[j];
+      }
+    }
+  }
+  const size_t sortedSize = orderSize;
+  for (size_t i = 0; i < this->nodesSize; ++i) {
+    if (inDegree[i] != 0) {
+      order[orderSize++] = i;
+    }
+  }
+  free(inDegree);
+  return sortedSize;
 }
 
 static Node* Graph_FindNode(Graph const* graph, size_t nodeName) {
@@ -183,6 +369,17 @@ static Node* Graph_FindNode(Graph const* graph, size_t nodeName) {
   return NULL;
 }
 
+// Node entry is about. Graph dropping finished nodes may have dropped it, otherwise log is broken.
+static Node* Graph_FindLogNode(Graph const* graph, const struct LogBook* logBook, const LogEntry* log) {
+  Node* node = Graph_FindNode(graph, log->nodeName);
+  if (node == NULL && !Graph_Retains(graph)) {
+    fprintf(stderr, "Unable to find node '%s' at log %ld", LogBook_GetNodeName(logBook, log->nodeName),
+            log->timestamp);
+    exit(10);
+  }
+  return node;
+}
+
 static Edge* Graph_FindEdge(Graph const* graph, size_t source, size_t destination) {
   for (Edge* it = graph->edges; it < graph->edges + graph->edgesSize; ++it) {
     if (source == it->source && destination == it->destination) {
@@ -191,3 +388,130 @@ static Edge* Graph_FindEdge(Graph const* graph, size_t source, size_t destinatio
   }
   return NULL;
 }
+
+static void Graph_PushEdge(Graph* this, size_t source, size_t destination) {
+  if (this->edgesSize == this->edgesCapacity) {
+    this->edgesCapacity = this->edgesCapacity ? this->edgesCapacity * 2 : 64;
+    this->edges = realloc(this->edges, this->edgesCapacity * sizeof(Edge));
+    if (this->edges == NULL) {
+      perror("Cannot realloc memory for Graph edges");
+      exit(10);
+    }
+  }
+  this->edges[this->edgesSize++] = (Edge){.source = source, .destination = destination};
+}
+
+static void Graph_Finish(Graph* this, Node* node, size_t entry, time_t timestamp) {
+  node->finishedEntry = entry;
+  if (!Graph_Retains(this)) {
+    return;
+  }
+  if (this->finishedSize == this->finishedCapacity) {
+    if (this->finishedBegin > 0) {
+      // queue is shifted back instead of growing, so it stays proportional to finished nodes retained
+      this->finishedSize -= this->finishedBegin;
+      memmove(this->finished, this->finished + this->finishedBegin, this->finishedSize * sizeof(FinishedNode));
+      this->finishedBegin = 0;
+    }
+    if (this->finishedSize == this->finishedCapacity) {
+      this->finished = Graph_Grow(this->finished, &this->finishedCapacity, sizeof(FinishedNode));
+    }
+  }
+  this->finished[this->finishedSize++] = (FinishedNode){.id = node->id, .entry = entry, .timestamp = timestamp};
+}
+
+// Nodes are queued in order of finishing, so expired ones are all at the front. Node started again since, or
+// finished again later, is left for its later record.
+static void Graph_DropExpired(Graph* this, size_t entry, time_t timestamp) {
+  size_t droppedSize = 0;
+  for (; this->finishedBegin < this->finishedSize; ++this->finishedBegin) {
+    const FinishedNode* finished = &this->finished[this->finishedBegin];
+    if (!(this->retention.entries > 0 && entry - finished->entry >= this->retention.entries) &&
+        !(this->retention.seconds > 0 && timestamp - finished->timestamp >= this->retention.seconds)) {
+      break;
+    }
+    const size_t slot = this->slotOfId[finished->id];
+    if (slot == (size_t)-1 || this->nodes[slot].status != EStatus_Finished ||
+        this->nodes[slot].finishedEntry != finished->entry || this->nodes[slot].nodeName == GRAPH_DROPPED) {
+      continue;
+    }
+    this->nodes[slot].nodeName = GRAPH_DROPPED;
+    ++droppedSize;
+  }
+  if (droppedSize > 0) {
+    Graph_Compact(this, droppedSize);
+  }
+}
+
+// Dropped slots are refilled with nodes moved from the end, so nodes stay dense and new ones take freed slots. Edges
+// and dependencies are rewritten in one pass over them.
+static void Graph_Compact(Graph* this, size_t droppedSize) {
+  size_t* newSlots = malloc(this->nodesSize * sizeof(size_t));
+  if (newSlots == NULL) {
+    perror("Cannot malloc memory for Graph");
+    exit(10);
+  }
+  for (size_t i = 0; i < this->nodesSize; ++i) {
+    newSlots[i] = i;
+    if (this->nodes[i].nodeName == GRAPH_DROPPED) {
+      newSlots[i] = (size_t)-1;
+      this->slotOfId[this->nodes[i].id] = (size_t)-1;
+      --this->statusCounts[EStatus_Finished];
+    }
+  }
+  const size_t liveSize = this->nodesSize - droppedSize;
+  size_t tail = this->nodesSize;
+  for (size_t hole = 0; hole < liveSize; ++hole) {
+    if (newSlots[hole] != (size_t)-1) {
+      continue;
+    }
+    do {
+      --tail;
+    } while (newSlots[tail] == (size_t)-1);
+    newSlots[tail] = hole;
+    this->nodes[hole] = this->nodes[tail];
+    this->slotOfId[this->nodes[hole].id] = hole;
+  }
+  this->nodesSize = liveSize;
+  this->droppedSize += droppedSize;
+
+  size_t edgesSize = 0;
+  for (const Edge* edge = this->edges; edge < this->edges + this->edgesSize; ++edge) {
+    const size_t source = newSlots[edge->source];
+    const size_t destination = newSlots[edge->destination];
+    if (source != (size_t)-1 && destination != (size_t)-1) {
+      this->edges[edgesSize++] = (Edge){.source = source, .destination = destination};
+    }
+  }
+  this->edgesSize = edgesSize;
+  for (Node* node = this->nodes; node < this->nodes + this->nodesSize; ++node) {
+    size_t* kept = node->dependencies;
+    for (const size_t* dependency = node->dependencies; *dependency != (size_t)-1; ++dependency) {
+      if (newSlots[*dependency] != (size_t)-1) {
+        *kept++ = newSlots[*dependency];
+      }
+    }
+    *kept = (size_t)-1;
+  }
+  free(newSlots);
+
+  // memory follows nodes alive, not the whole history
+  if (this->nodesCapacity > 64 && this->nodesSize < this->nodesCapacity / 4) {
+    this->nodesCapacity /= 2;
+    this->nodes = realloc(this->nodes, this->nodesCapacity * sizeof(Node));
+    if (this->nodes == NULL) {
+      perror("Cannot realloc memory for Graph");
+      exit(10);
+    }
+  }
+}
+
+static void* Graph_Grow(void* items, size_t* capacity, size_t itemSize) {
+  *capacity = *capacity ? *capacity * 2 : 64;
+  items = realloc(items, *capacity * itemSize);
+  if (items == NULL) {
+    perror("Cannot realloc memory for Graph");
+    exit(10);
+  }
+  return items;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <raylib.h>
+#include <stdbool.h>
 #include <time.h>
 
 #include <LogBook.h>
@@ -9,6 +10,8 @@ typedef struct Node {
   time_t timestamp;
   EStatus status;
   size_t nodeName;
+  size_t id;             // order of addition in log, as node of NodeStats
+  size_t finishedEntry;  // last entry which finished node
   size_t dependencies[128]; //indexes of nodes in Graph.nodes
 } Node;
 
@@ -17,14 +20,54 @@ typedef struct Edge {
   size_t destination;
 } Edge;
 
+// Finished nodes are dropped once either of set limits passes since they finished, 0 means no limit
+typedef struct Retention {
+  size_t entries;
+  time_t seconds;
+} Retention;
+
+typedef struct FinishedNode {
+  size_t id;
+  size_t entry;
+  time_t timestamp;
+} FinishedNode;
+
 typedef struct Graph {
   Node* nodes;
   size_t nodesSize;
+  size_t nodesCapacity;
   Vector2* coordinates;
   Edge* edges;
   size_t edgesSize;
+  size_t edgesCapacity;
+  size_t statusCounts[EStatus_Size];
+  size_t* slotOfId;  // index in nodes of node with given id, (size_t)-1 once dropped
+  size_t idsSize;    // nodes added so far
+  Retention retention;
+  FinishedNode* finished;  // in order of finishing, dropped from finishedBegin
+  size_t finishedBegin;
+  size_t finishedSize;
+  size_t finishedCapacity;
+  size_t droppedSize;
 } Graph;
 
+// Reverse adjacency, Edge.destination of every Edge grouped by Edge.source
+typedef struct Dependents {
+  size_t* starts;  // nodesSize + 1 offsets into nodes
+  size_t* nodes;
+} Dependents;
+
 void Graph_Destroy(Graph* this);
 Graph Graph_Init(const struct LogBook* logBook, size_t currentLogIndex);
+Graph Graph_InitRetaining(const struct LogBook* logBook, size_t currentLogIndex, Retention retention);
+Graph Graph_Make(const struct LogBook* logBook);
+void Graph_SetRetention(Graph* this, Retention retention);
+bool Graph_Retains(const Graph* this);
+bool Graph_ParseRetention(const char* text, Retention* retention);
+void Graph_Apply(Graph* this, const struct LogBook* logBook, const LogEntry* log);
 void Graph_Copy(Graph* target, const Graph* source);
+size_t Graph_NodeIndex(const Graph* this, size_t nodeName);
+size_t Graph_NodeOfId(const Graph* this, size_t id);
+Dependents Graph_Dependents(const Graph* this);
+void Graph_DestroyDependents(Dependents* dependents);
+size_t Graph_TopologicalOrder(const Graph* this, const Dependents* dependents, size_t* order);
@@ -0,0 +1,416 @@
+#include "Grouping.h"
+#include "LogBook.h"
+#include "Workspace.h"
+
+#include <raygui.h>
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GROUPING_KEY_SIZE 256
+
+typedef struct GroupStyle {
+  const float WIDTH;
+  const float HEIGHT;
+  const float HORI_PADDING;
+  const float VERT_PADDING;
+  const float MARGIN;
+  const float STATUS_BAR_H;
+  const float LABELS_MIN_ZOOM;
+} GroupStyle;
+
+static GroupStyle GroupStyle_Default();
+static size_t Grouping_Key(const Grouping* this, const char* name, char* key);
+static size_t Grouping_Intern(Grouping* this, char* key);
+static uint32_t Grouping_Hash(const char* key);
+static void Grouping_Rehash(Grouping* this, size_t tableSize);
+static void Grouping_CollapseEdges(Grouping* this, const Graph* graph, const Bitset* shown);
+static void Grouping_Layout(Grouping* this);
+static void* Grouping_Alloc(size_t count, size_t size);
+
+Grouping Grouping_Init() {
+  return (Grouping){
+      .rule = EGroupRule_None,
+      .pattern = "",
+      .regexCompiled = false,
+      .groupOfNode = NULL,
+      .assignedSize = 0,
+      .assignedCapacity = 0,
+      .keys = StringContainer_Init(),
+      .groupsSize = 0,
+      .table = NULL,
+      .tableSize = 0,
+      .statusCounts = NULL,
+      .membersSizes = NULL,
+      .edges = NULL,
+      .edgesSize = 0,
+      .coordinates = NULL,
+      .spaceSize = {0, 0},
+  };
+}
+
+void Grouping_Destroy(Grouping* this) {
+  if (this->regexCompiled) {
+    regfree(&this->regex);
+  }
+  free(this->groupOfNode);
+  StringContainer_Destroy(&this->keys);
+  free(this->table);
+  free(this->statusCounts);
+  free(this->membersSizes);
+  free(this->edges);
+  free(this->coordinates);
+}
+
+// Returns false when regular expression does not compile, grouping is switched off then
+bool Grouping_SetRule(Grouping* this, int rule, const char* pattern) {
+  Grouping_Destroy(this);
+  *this = Grouping_Init();
+  this->rule = rule;
+  snprintf(this->pattern, sizeof(this->pattern), "%s", pattern);
+  if (rule == EGroupRule_Regex) {
+    this->regexCompiled = regcomp(&this->regex, this->pattern, REG_EXTENDED) == 0;
+    if (!this->regexCompiled) {
+      this->rule = EGroupRule_None;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Grouping_IsActive(const Grouping* this) {
+  return this->rule != EGroupRule_None;
+}
+
+// Cost is linear in nodes and edges of graph, plus nodes added since previous update; layout and drawing depend on
+// number of groups only. Shown is filter by node index, NULL when every node is.
+void Grouping_Update(Grouping* this, const Graph* graph, const struct LogBook* logBook, const Bitset* shown) {
+  if (!Grouping_IsActive(this)) {
+    return;
+  }
+  if (shown && shown->size < graph->nodesSize) {
+    shown = NULL;  // evaluated for another graph
+  }
+  if (graph->idsSize > this->assignedCapacity) {
+    this->assignedCapacity = graph->idsSize * 2;
+    this->groupOfNode = realloc(this->groupOfNode, this->assignedCapacity * sizeof(size_t));
+    if (this->groupOfNode == NULL) {
+      perror("Cannot realloc memory for Grouping");
+      exit(10);
+    }
+  }
+  char key[GROUPING_KEY_SIZE];
+  for (; this->assignedSize < graph->idsSize; ++this->assignedSize) {
+    const size_t name = logBook->stats.nodeNames[this->assignedSize];  // node may be dropped from graph already
+    Grouping_Key(this, LogBook_GetNodeName(logBook, name), key);
+    this->groupOfNode[this->assignedSize] = Grouping_Intern(this, key);
+  }
+
+  free(this->statusCounts);
+  free(this->membersSizes);
+  this->statusCounts = Grouping_Alloc(this->groupsSize * EStatus_Size, sizeof(size_t));
+  this->membersSizes = Grouping_Alloc(this->groupsSize, sizeof(size_t));
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    if (shown && !Bitset_Test(shown, i)) {
+      continue;
+    }
+    const size_t group = this->groupOfNode[graph->nodes[i].id];
+    ++this->membersSizes[group];
+    ++this->statusCounts[group * EStatus_Size + graph->nodes[i].status];
+  }
+  Grouping_CollapseEdges(this, graph, shown);
+  Grouping_Layout(this);
+}
+
+size_t Grouping_VisibleGroupsSize(const Grouping* this) {
+  size_t visible = 0;
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    visible += this->membersSizes[group] > 0;
+  }
+  return visible;
+}
+
+Vector2 Grouping_GetSpaceSize(const Grouping* this, const Rectangle* panelRect, float zoom) {
+  return (Vector2){
+      fmaxf(this->spaceSize.x * zoom, panelRect->width - 2),
+      fmaxf(this->spaceSize.y * zoom, panelRect->height - 2),
+  };
+}
+
+void Grouping_Draw(const Grouping* this, const Rectangle* view, const Vector2* scrollOffset, float zoom) {
+  GroupStyle gs = GroupStyle_Default();
+  const Rectangle visibleArea = {
+      .x = (view->x - scrollOffset->x) / zoom,
+      .y = (view->y - scrollOffset->y) / zoom,
+      .width = view->width / zoom,
+      .height = view->height / zoom,
+  };
+
+  const Color lineColor = GetColor(GuiGetStyle(DEFAULT, LINE_COLOR));
+  for (const GroupEdge* edge = this->edges; edge < this->edges + this->edgesSize; ++edge) {
+    const Vector2 source = this->coordinates[edge->source];
+    const Vector2 destination = this->coordinates[edge->destination];
+    Vector2 strip[4] = {
+        {source.x + gs.WIDTH, source.y + gs.HEIGHT / 2},
+        {(source.x + gs.WIDTH + destination.x) / 2 + (edge->source % 9), source.y + gs.HEIGHT / 2},
+        {(source.x + gs.WIDTH + destination.x) / 2 + (edge->source % 9), destination.y + gs.HEIGHT / 2},
+        {destination.x, destination.y + gs.HEIGHT / 2},
+    };
+    const Rectangle bounds = {fminf(strip[0].x, strip[3].x), fminf(strip[0].y, strip[3].y),
+                              fabsf(strip[3].x - strip[0].x) + 9, fabsf(strip[3].y - strip[0].y) + 1};
+    if (!CheckCollisionRecs(visibleArea, bounds)) {
+      continue;
+    }
+    for (size_t i = 0; i < 4; ++i) {
+      strip[i].x = scrollOffset->x + strip[i].x * zoom;
+      strip[i].y = scrollOffset->y + strip[i].y * zoom;
+    }
+    DrawLineStrip(strip, 4, lineColor);
+  }
+
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    const Vector2 position = this->coordinates[group];
+    if (this->membersSizes[group] == 0 ||
+        !CheckCollisionRecs(visibleArea, (Rectangle){position.x, position.y, gs.WIDTH, gs.HEIGHT})) {
+      continue;
+    }
+    const Rectangle bounds = {
+        .x = scrollOffset->x + position.x * zoom,
+        .y = scrollOffset->y + position.y * zoom,
+        .width = gs.WIDTH * zoom,
+        .height = gs.HEIGHT * zoom,
+    };
+    DrawRectangleRec(bounds, GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+    DrawRectangleLinesEx(bounds, 1, GetColor(GuiGetStyle(DEFAULT, BORDER_COLOR_NORMAL)));
+
+    // bar of statuses of members along the bottom, whole box when labels would not fit
+    const float barH = zoom < gs.LABELS_MIN_ZOOM ? bounds.height : gs.STATUS_BAR_H * zoom;
+    float x = bounds.x;
+    for (int status = 0; status < EStatus_Size; ++status) {
+      const float w = bounds.width * this->statusCounts[group * EStatus_Size + status] / this->membersSizes[group];
+      DrawRectangleRec((Rectangle){x, bounds.y + bounds.height - barH, w, barH}, Workspace_StatusColor(status, false));
+      x += w;
+    }
+    if (zoom < gs.LABELS_MIN_ZOOM) {
+      continue;
+    }
+    const size_t* counts = this->statusCounts + group * EStatus_Size;
+    char text[96];
+    snprintf(text, sizeof(text), "%zu nodes: %zu waiting, %zu ongoing", this->membersSizes[group],
+             counts[EStatus_Waiting], counts[EStatus_Ongoing]);
+    const float lineH = (bounds.height - barH) / 2;
+    GuiLabel((Rectangle){bounds.x + 4, bounds.y, bounds.width - 8, lineH}, StringContainer_At(&this->keys, group));
+    GuiLabel((Rectangle){bounds.x + 4, bounds.y + lineH, bounds.width - 8, lineH}, text);
+  }
+}
+
+static GroupStyle GroupStyle_Default() {
+  return (GroupStyle){
+      .WIDTH = 220,
+      .HEIGHT = 48,
+      .HORI_PADDING = 60,
+      .VERT_PADDING = 16,
+      .MARGIN = 10,
+      .STATUS_BAR_H = 8,
+      .LABELS_MIN_ZOOM = 0.75,
+  };
+}
+
+// Family of name: up to its first digit, up to last delimiter, or match of regular expression (its first
+// subexpression if there is one). Name not fitting the rule is a family of its own.
+static size_t Grouping_Key(const Grouping* this, const char* name, char* key) {
+  size_t begin = 0;
+  size_t end = strlen(name);
+  switch (this->rule) {
+    case EGroupRule_Prefix: {
+      size_t i = 0;
+      while (name[i] && !isdigit((unsigned char)name[i])) {
+        ++i;
+      }
+      end = i > 0 ? i : end;
+      break;
+    }
+    case EGroupRule_Delimiter: {
+      const char* delimiters = this->pattern[0] ? this->pattern : "/";
+      for (size_t i = end; i > 0; --i) {
+        if (strchr(delimiters, name[i - 1])) {
+          end = i - 1 > 0 ? i - 1 : end;
+          break;
+        }
+      }
+      break;
+    }
+    case EGroupRule_Regex: {
+      regmatch_t matches[2];
+      if (regexec(&this->regex, name, 2, matches, 0) == 0) {
+        const regmatch_t* match = matches[1].rm_so >= 0 ? &matches[1] : &matches[0];
+        if (match->rm_eo > match->rm_so) {
+          begin = match->rm_so;
+          end = match->rm_eo;
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  const size_t length = end - begin < GROUPING_KEY_SIZE - 1 ? end - begin : GROUPING_KEY_SIZE - 1;
+  memcpy(key, name + begin, length);
+  key[length] = '\0';
+  return length;
+}
+
+static size_t Grouping_Intern(Grouping* this, char* key) {
+  if (2 * (this->groupsSize + 1) > this->tableSize) {
+    Grouping_Rehash(this, this->tableSize ? this->tableSize * 2 : 256);
+  }
+  size_t slot = Grouping_Hash(key) & (this->tableSize - 1);
+  while (this->table[slot] != 0) {
+    if (strcmp(StringContainer_At(&this->keys, this->table[slot] - 1), key) == 0) {
+      return this->table[slot] - 1;
+    }
+    slot = (slot + 1) & (this->tableSize - 1);
+  }
+  StringContainer_Append(&this->keys, key);
+  this->table[slot] = ++this->groupsSize;
+  return this->groupsSize - 1;
+}
+
+// FNV-1a
+static uint32_t Grouping_Hash(const char* key) {
+  uint32_t hash = 2166136261u;
+  for (; *key; ++key) {
+    hash = (hash ^ (unsigned char)*key) * 16777619u;
+  }
+  return hash;
+}
+
+static void Grouping_Rehash(Grouping* this, size_t tableSize) {
+  free(this->table);
+  this->tableSize = tableSize;
+  this->table = Grouping_Alloc(tableSize, sizeof(uint32_t));
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    size_t slot = Grouping_Hash(StringContainer_At(&this->keys, group)) & (tableSize - 1);
+    while (this->table[slot] != 0) {
+      slot = (slot + 1) & (tableSize - 1);
+    }
+    this->table[slot] = group + 1;
+  }
+}
+
+// Edges bucketed by source group, destinations of one source are deduplicated by stamping them with it. Edges
+// touching a node hidden by filter are left out.
+static void Grouping_CollapseEdges(Grouping* this, const Graph* graph, const Bitset* shown) {
+  size_t* starts = Grouping_Alloc(this->groupsSize + 1, sizeof(size_t));
+  size_t* destinations = Grouping_Alloc(graph->edgesSize, sizeof(size_t));
+  size_t* stamps = Grouping_Alloc(this->groupsSize, sizeof(size_t));  // 1 + source which last reached group
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    if (shown && (!Bitset_Test(shown, edge->source) || !Bitset_Test(shown, edge->destination))) {
+      continue;
+    }
+    ++starts[this->groupOfNode[graph->nodes[edge->source].id] + 1];
+  }
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    starts[group + 1] += starts[group];
+  }
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    if (shown && (!Bitset_Test(shown, edge->source) || !Bitset_Test(shown, edge->destination))) {
+      continue;
+    }
+    const size_t source = this->groupOfNode[graph->nodes[edge->source].id];
+    destinations[starts[source] + stamps[source]++] = this->groupOfNode[graph->nodes[edge->destination].id];
+  }
+  memset(stamps, 0, this->groupsSize * sizeof(size_t));
+
+  free(this->edges);
+  this->edges = Grouping_Alloc(graph->edgesSize, sizeof(GroupEdge));
+  this->edgesSize = 0;
+  for (size_t source = 0; source < this->groupsSize; ++source) {
+    for (size_t i = starts[source]; i < starts[source + 1]; ++i) {
+      const size_t destination = destinations[i];
+      if (destination == source || stamps[destination] == source + 1) {
+        continue;
+      }
+      stamps[destination] = source + 1;
+      this->edges[this->edgesSize++] = (GroupEdge){.source = source, .destination = destination};
+    }
+  }
+  free(stamps);
+  free(destinations);
+  free(starts);
+}
+
+// Columns by longest path of dependencies, groups on cycles go to one column after the rest
+static void Grouping_Layout(Grouping* this) {
+  GroupStyle gs = GroupStyle_Default();
+  size_t* inDegree = Grouping_Alloc(this->groupsSize, sizeof(size_t));
+  size_t* levels = Grouping_Alloc(this->groupsSize, sizeof(size_t));
+  size_t* order = Grouping_Alloc(this->groupsSize, sizeof(size_t));
+  size_t* starts = Grouping_Alloc(this->groupsSize + 1, sizeof(size_t));
+  size_t* dependents = Grouping_Alloc(this->edgesSize, sizeof(size_t));
+  for (const GroupEdge* edge = this->edges; edge < this->edges + this->edgesSize; ++edge) {
+    ++inDegree[edge->destination];
+    ++starts[edge->source + 1];
+  }
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    starts[group + 1] += starts[group];
+  }
+  // edges are already grouped by source
+  for (size_t i = 0; i < this->edgesSize; ++i) {
+    dependents[i] = this->edges[i].destination;
+  }
+
+  size_t orderSize = 0;
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    if (inDegree[group] == 0) {
+      order[orderSize++] = group;
+    }
+  }
+  size_t maxLevel = 0;
+  for (size_t head = 0; head < orderSize; ++head) {
+    const size_t group = order[head];
+    maxLevel = levels[group] > maxLevel ? levels[group] : maxLevel;
+    for (size_t i = starts[group]; i < starts[group + 1]; ++i) {
+      const size_t dependent = dependents[i];
+      levels[dependent] = levels[group] + 1 > levels[dependent] ? levels[group] + 1 : levels[dependent];
+      if (--inDegree[dependent] == 0) {
+        order[orderSize++] = dependent;
+      }
+    }
+  }
+
+  free(this->coordinates);
+  this->coordinates = Grouping_Alloc(this->groupsSize, sizeof(Vector2));
+  size_t* rows = Grouping_Alloc(maxLevel + 2, sizeof(size_t));
+  this->spaceSize = (Vector2){0, 0};
+  for (size_t group = 0; group < this->groupsSize; ++group) {
+    if (this->membersSizes[group] == 0) {
+      continue;
+    }
+    const size_t level = inDegree[group] == 0 ? levels[group] : maxLevel + 1;
+    this->coordinates[group] = (Vector2){
+        .x = gs.MARGIN + level * (gs.WIDTH + gs.HORI_PADDING),
+        .y = gs.MARGIN + rows[level]++ * (gs.HEIGHT + gs.VERT_PADDING),
+    };
+    this->spaceSize.x = fmaxf(this->spaceSize.x, this->coordinates[group].x + gs.WIDTH + gs.MARGIN);
+    this->spaceSize.y = fmaxf(this->spaceSize.y, this->coordinates[group].y + gs.HEIGHT + gs.MARGIN);
+  }
+  free(rows);
+  free(dependents);
+  free(starts);
+  free(order);
+  free(levels);
+  free(inDegree);
+}
+
+static void* Grouping_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for Grouping");
+    exit(10);
+  }
+  return memory;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Bitset.h"
+#include "Graph.h"
+#include "StringContainer.h"
+
+#include <raylib.h>
+#include <regex.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define GROUPING_PATTERN_SIZE 64
+
+typedef enum { EGroupRule_None, EGroupRule_Prefix, EGroupRule_Delimiter, EGroupRule_Regex } EGroupRule;
+
+typedef struct GroupEdge {
+  size_t source;
+  size_t destination;
+} GroupEdge;
+
+// Families of nodes collapsed into one aggregate node each. Group of node is kept between snapshots of one log, only
+// nodes added since are assigned, and aggregates are recounted from nodes of current graph let through by filter.
+// Grouping_SetRule starts over.
+typedef struct Grouping {
+  int rule;
+  char pattern[GROUPING_PATTERN_SIZE];  // delimiters or regular expression
+  regex_t regex;
+  bool regexCompiled;
+  size_t* groupOfNode;  // by Node.id
+  size_t assignedSize;
+  size_t assignedCapacity;
+  StringContainer keys;  // name of every group
+  size_t groupsSize;
+  uint32_t* table;  // 1 + group of key hash, open addressing
+  size_t tableSize;
+  size_t* statusCounts;  // EStatus_Size per group, in current graph
+  size_t* membersSizes;  // nodes of group in current graph
+  GroupEdge* edges;      // deduplicated edges between different groups
+  size_t edgesSize;
+  Vector2* coordinates;  // of groups
+  Vector2 spaceSize;
+} Grouping;
+
+Grouping Grouping_Init();
+void Grouping_Destroy(Grouping* this);
+bool Grouping_SetRule(Grouping* this, int rule, const char* pattern);
+bool Grouping_IsActive(const Grouping* this);
+void Grouping_Update(Grouping* this, const Graph* graph, const struct LogBook* logBook, const Bitset* shown);
+size_t Grouping_VisibleGroupsSize(const Grouping* this);
+Vector2 Grouping_GetSpaceSize(const Grouping* this, const Rectangle* panelRect, float zoom);
+void Grouping_Draw(const Grouping* this, const Rectangle* view, const Vector2* scrollOffset, float zoom);
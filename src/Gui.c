@@ -1,7 +1,15 @@
 #include "Gui.h"
 #include "Core.h"
+#include "Diff.h"
+#include "Export.h"
+#include "Filter.h"
+#include "Focus.h"
 #include "FlowLayout.h"
 #include "FrameList.h"
+#include "Grouping.h"
+#include "Profiler.h"
+#include "Reachability.h"
+#include "Timeline.h"
 #include "Workspace.h"
 
 #define RAYGUI_IMPLEMENTATION
@@ -25,19 +33,30 @@
 #include <gui_window_file_dialog.h>
 #undef GUI_WINDOW_FILE_DIALOG_IMPLEMENTATION
 
+#include <math.h>
 #include <raylib.h>
 #include <stdio.h>
+#include <string.h>
 
 const float SELECTED_FILE_LABEL_W = 289;
+const float ANIMATION_DURATION = 0.8;  // seconds
+#define SEARCH_RESULTS_MAX 10
+#define STATS_TOP_MAX 100
+typedef enum { EWorkspaceView_Diagram, EWorkspaceView_Timeline } EWorkspaceView;
 const char* const GUI_STYLES_COMBOLIST =
     "default;Jungle;Candy;Lavanda;Cyber;Terminal;Ashes;Bluish;Dark;Cherry;Sunny;Enefete";
 
 typedef struct Gui {
   Workspace* workspace;
+  int workspaceView;
+  Timeline timeline;
+  FrameList frameList;
   const char* loadFileText;
   GuiWindowFileDialogState fileDialogState;
   char displayedFileName[128];
-  char* newFileName;
+  const char* newFileName;
+  char logFileName[2048];
+  int exportFormat;
   int activeStyle;
   int prevStyle;
   float toolbarHeight;
@@ -52,6 +71,42 @@ typedef struct Gui {
   bool graphNeedsToChange;
   bool showFrameList;
   float changeProcent;
+  int targetFps;
+  bool idleMode;
+  bool waitedForEvents;
+  int redrawRequests;
+  size_t hoveredNode;
+  bool showDiagnostics;
+  Vector2 diagnosticsScrollOffset;
+  Rectangle diagnosticsView;
+  bool showProfiler;
+  char searchText[64];
+  char searchedText[64];  // query searchResults were computed for
+  const char* searchedNames;  // storage of index searchResults point into
+  bool searchEditMode;
+  Rectangle searchBoxRect;
+  size_t searchResults[SEARCH_RESULTS_MAX];      // name offsets
+  size_t searchResultNodes[SEARCH_RESULTS_MAX];  // indexes in current graph, (size_t)-1 when absent from it
+  size_t searchResultsSize;
+  bool showStats;
+  int statsKey;
+  size_t statsTop[STATS_TOP_MAX];  // nodes of NodeStats
+  size_t statsTopSize;
+  int statsTopKey;                     // statsKey statsTop was computed for
+  const NodeChange* statsTopChanges;  // storage of NodeStats statsTop was computed for
+  Vector2 statsScrollOffset;
+  Rectangle statsView;
+  bool showDiff;
+  size_t diffBase;  // entry current one is compared with
+  Diff diff;
+  int groupRule;
+  char groupPattern[GROUPING_PATTERN_SIZE];
+  bool groupEditMode;
+  Grouping grouping;  // drawn instead of nodes when active
+  bool nodesStale;    // graph changed while grouped, nodes are laid out once grouping is switched off
+  char filterText[FILTER_TEXT_SIZE];
+  bool filterEditMode;
+  Filter filter;
 } Gui;
 
 static void Gui_HandleNewFileName(Gui* this);
@@ -59,6 +114,28 @@ static void Gui_HandleFileSelected(Gui* this, Core* core);
 static void Gui_HandleGraphChange(Gui* this, Core* core);
 static void Gui_DrawToolbar(Gui* this, Core* core);
 static void Gui_DrawWorkspacePanel(Gui* this, Core* core, const Rectangle rect);
+static void Gui_DrawTimelinePanel(Gui* this, Core* core, const Rectangle rect);
+static bool Gui_HandleWorkspaceZoom(Gui* this, const Rectangle rect);
+static void Gui_UpdateEventWaiting(Gui* this);
+static void Gui_SeekTo(Gui* this, Core* core, size_t entry);
+static void Gui_HandleKeyboard(Gui* this, Core* core);
+static void Gui_DrawDiagnosticsPanel(Gui* this, Core* core, const Rectangle rect);
+static void Gui_ExportSnapshot(Gui* this, Core* core);
+static void Gui_UpdateSearchResults(Gui* this, const Core* core);
+static void Gui_ResolveSearchResults(Gui* this, const Core* core);
+static void Gui_DrawSearchResults(Gui* this, Core* core);
+static void Gui_JumpToNode(Gui* this, Core* core, size_t nodeName);
+static void Gui_SelectNode(Gui* this, Core* core, size_t nodeIndex);
+static void Gui_Relayout(Gui* this, Core* core);
+static void Gui_UpdateDiff(Gui* this, const Core* core);
+static void Gui_UpdateGrouping(Gui* this, const Core* core);
+static void Gui_LayOutNodes(Gui* this, Core* core);
+static void Gui_UpdateFilter(Gui* this, const Core* core);
+static void Gui_DrawStatsPanel(Gui* this, Core* core, const Rectangle rect);
+static void Gui_DrawStatsHistogram(const NodeStats* stats, int status, Color color, const Rectangle rect);
+#ifdef DEPVIEW_PROFILER
+static void Gui_DrawProfilerOverlay(const Rectangle rect);
+#endif
 
 size_t Gui_SizeOf() {
   return sizeof(Gui);
@@ -66,10 +143,15 @@ size_t Gui_SizeOf() {
 void Gui_Init(Gui* this) {
   *this = (Gui){
       .workspace = malloc(Workspace_SizeOf()),
+      .workspaceView = EWorkspaceView_Diagram,
+      .timeline = Timeline_Init(),
+      .frameList = FrameList_Init(),
       .loadFileText = "LOAD FILE",
       .fileDialogState = InitGuiWindowFileDialog(NULL),
       .displayedFileName = "",
       .newFileName = NULL,
+      .logFileName = "",
+      .exportFormat = EExportFormat_Svg,
       .activeStyle = 4,
       .prevStyle = 0,
       .toolbarHeight = 24,
@@ -83,17 +165,54 @@ void Gui_Init(Gui* this) {
       .scrollPanelBoundsOffset = {.x = 0, .y = 0},
       .graphNeedsToChange = false,
       .changeProcent = 1.0,
+      .targetFps = 60,
+      .idleMode = true,
+      .waitedForEvents = false,
+      .redrawRequests = 0,
+      .hoveredNode = (size_t)-1,
+      .showDiagnostics = false,
+      .diagnosticsScrollOffset = {.x = 0, .y = 0},
+      .diagnosticsView = {.x = 0, .y = 0, .width = 0, .height = 0},
+      .showProfiler = false,
+      .searchText = "",
+      .searchedText = "",
+      .searchedNames = NULL,
+      .searchEditMode = false,
+      .searchBoxRect = {.x = 0, .y = 0, .width = 0, .height = 0},
+      .searchResultsSize = 0,
+      .showStats = false,
+      .statsKey = NODESTATS_LIFETIME,
+      .statsTopSize = 0,
+      .statsTopKey = -1,
+      .statsTopChanges = NULL,
+      .statsScrollOffset = {.x = 0, .y = 0},
+      .statsView = {.x = 0, .y = 0, .width = 0, .height = 0},
+      .showDiff = false,
+      .diffBase = 0,
+      .diff = Diff_Init(),
+      .groupRule = EGroupRule_None,
+      .groupPattern = "",
+      .groupEditMode = false,
+      .grouping = Grouping_Init(),
+      .nodesStale = false,
+      .filterText = "",
+      .filterEditMode = false,
+      .filter = Filter_Init(),
   };
   Workspace_Init(this->workspace);
   memset(this->displayedFileName, '\0', sizeof(this->displayedFileName) / sizeof(char));
 }
 void Gui_Destroy(Gui* this) {
   Workspace_Destroy(this->workspace);
+  Diff_Destroy(&this->diff);
+  Grouping_Destroy(&this->grouping);
+  Filter_Destroy(&this->filter);
 }
 
 void Gui_Loop(Gui* this, Core* core) {
   Gui_HandleNewFileName(this);
   Gui_HandleFileSelected(this, core);
+  Gui_HandleKeyboard(this, core);
   Gui_HandleGraphChange(this, core);
 }
 
@@ -101,10 +220,19 @@ void Gui_SetActiveStyle(Gui* this, int activeStyle) {
   this->activeStyle = activeStyle;
 }
 
-void Gui_SetNewFileName(Gui* this, char* fileName) {
+void Gui_SetNewFileName(Gui* this, const char* fileName) {
   this->newFileName = fileName;
 }
 
+void Gui_SetFrameRate(Gui* this, int targetFps, bool idleMode) {
+  this->targetFps = targetFps;
+  this->idleMode = idleMode;
+}
+
+void Gui_RequestRedraw(Gui* this) {
+  this->redrawRequests = 2;
+}
+
 static void Gui_HandleNewFileName(Gui* this) {
   if (this->newFileName != NULL && this->newFileName[0] != '\0') {
     float textWidth = MeasureText(this->newFileName, GuiGetFont().baseSize);
@@ -119,6 +247,7 @@ static void Gui_HandleNewFileName(Gui* this) {
     } else {
       snprintf(this->displayedFileName, 128, "%.127s", this->newFileName);
     }
+    snprintf(this->logFileName, sizeof(this->logFileName), "%s", this->newFileName);
     this->newFileName = NULL;
   }
 }
@@ -129,25 +258,68 @@ static void Gui_HandleFileSelected(Gui* this, Core* core) {
     snprintf(core->selectedFileName, 2048, "%s/%s", this->fileDialogState.dirPathText,
              this->fileDialogState.fileNameText);
     this->fileDialogState.SelectFilePressed = false;
-    this->newFileName = core->selectedFileName;
   }
 }
 
 void Gui_TriggerGraphChange(Gui* this) {
   this->graphNeedsToChange = true;
+  this->showDiff = false;  // base entry belongs to previous log
+  Workspace_SetDiff(this->workspace, NULL);
+  Grouping_SetRule(&this->grouping, this->groupRule, this->groupPattern);  // groups belong to previous log
+  Filter_Compile(&this->filter, this->filterText);                         // and so do matched names
+  FrameList_CenterOn(&this->frameList, 0);
+}
+
+static void Gui_HandleKeyboard(Gui* this, Core* core) {
+  if (this->fileDialogState.windowActive) {
+    return;
+  }
+#ifdef DEPVIEW_PROFILER
+  if (IsKeyPressed(KEY_F3)) {
+    this->showProfiler = !this->showProfiler;
+  }
+#endif
+  if (this->searchEditMode || this->groupEditMode || this->filterEditMode) {
+    return;  // arrows move text cursor
+  }
+  if (IsKeyPressed(KEY_UP)) {
+    Gui_SeekTo(this, core, 0 == core->currentLog ? core->currentLog : core->currentLog - 1);
+  } else if (IsKeyPressed(KEY_DOWN)) {
+    Gui_SeekTo(this, core, core->currentLog + 1);
+  }
+}
+
+static void Gui_SeekTo(Gui* this, Core* core, size_t entry) {
+  if (core->logBook.entriesSize == 0) {
+    return;
+  }
+  core->currentLog = entry >= core->logBook.entriesSize ? core->logBook.entriesSize - 1 : entry;
+  this->graphNeedsToChange = true;
+  FrameList_CenterOn(&this->frameList, core->currentLog);
 }
 
 static void Gui_HandleGraphChange(Gui* this, Core* core) {
   if (this->graphNeedsToChange) {
+    PROFILER_SCOPE(EPhase_GraphChange);
     this->changeProcent = 0.0;
     if (core->logBook.entriesSize > core->currentLog) {
       printf("Graph update! (%ld)\n", core->logBook.entries[core->currentLog].timestamp);
       Graph_Destroy(&core->oldGraph);
       Graph_Copy(&core->oldGraph, &core->currentGraph);
       Graph_Destroy(&core->currentGraph);
-      core->currentGraph = Graph_Init(&core->logBook, core->currentLog);
+      core->currentGraph = Graph_InitRetaining(&core->logBook, core->currentLog, core->retention);
+      PROFILER_COUNTER(ECounter_Nodes, core->currentGraph.nodesSize);
+      PROFILER_COUNTER(ECounter_Edges, core->currentGraph.edgesSize);
       snprintf(this->selectedTimestamp, 24, "%ld", core->logBook.entries[core->currentLog].timestamp);
-      Workspace_BuildLayout(this->workspace, &core->currentGraph);
+      Gui_UpdateFilter(this, core);
+      if (Grouping_IsActive(&this->grouping)) {
+        this->nodesStale = true;  // only groups are laid out
+      } else {
+        Gui_LayOutNodes(this, core);
+      }
+      Gui_UpdateDiff(this, core);  // its summary is shown in both views
+      Gui_UpdateGrouping(this, core);
+      Gui_ResolveSearchResults(this, core);
     }
     this->graphNeedsToChange = false;
   }
@@ -156,7 +328,7 @@ static void Gui_HandleGraphChange(Gui* this, Core* core) {
 void Gui_InitWindow(Gui* this, char* title) {
   SetConfigFlags(FLAG_WINDOW_RESIZABLE);
   InitWindow(this->screenWidth, this->screenHeight, title);
-  SetTargetFPS(60);
+  SetTargetFPS(this->targetFps);
 }
 
 bool Gui_ShouldWindowClose() {
@@ -217,17 +389,57 @@ void Gui_Draw(Gui* this, Core* core) {
                             ? FRAMELIST_X - PANEL_X - this->windowPaddings.x - this->scrollPanelBoundsOffset.x
                             : this->screenWidth - PANEL_X - this->windowMargins.x - this->scrollPanelBoundsOffset.x;
   const float PANEL_H = this->screenHeight - PANEL_Y - this->windowMargins.y - this->scrollPanelBoundsOffset.y;
-
-  Gui_DrawWorkspacePanel(this, core, (Rectangle){PANEL_X, PANEL_Y, PANEL_W, PANEL_H});
+  const float DIAGNOSTICS_H = this->showDiagnostics ? 160 : 0;
+  const float STATS_H = this->showStats ? 200 : 0;
+  const float WORKSPACE_H = PANEL_H - (this->showDiagnostics ? DIAGNOSTICS_H + this->windowPaddings.y : 0) -
+                            (this->showStats ? STATS_H + this->windowPaddings.y : 0);
+
+  Gui_DrawWorkspacePanel(this, core, (Rectangle){PANEL_X, PANEL_Y, PANEL_W, WORKSPACE_H});
+  if (this->showDiagnostics) {
+    Rectangle diagnostics_rect = {PANEL_X, PANEL_Y + PANEL_H - DIAGNOSTICS_H, PANEL_W, DIAGNOSTICS_H};
+    Gui_DrawDiagnosticsPanel(this, core, diagnostics_rect);
+  }
+  if (this->showStats) {
+    Rectangle stats_rect = {PANEL_X, PANEL_Y + WORKSPACE_H + this->windowPaddings.y, PANEL_W, STATS_H};
+    Gui_DrawStatsPanel(this, core, stats_rect);
+  }
   if (this->showFrameList) {
     Rectangle framelist_rect = {FRAMELIST_X, PANEL_Y, FRAMELIST_W, PANEL_H};
-    FrameList_Draw(framelist_rect, &core->currentLog, &this->graphNeedsToChange, &core->logBook);
+    FrameList_Draw(&this->frameList, framelist_rect, &core->currentLog, &this->graphNeedsToChange, &core->logBook);
+  }
+#ifdef DEPVIEW_PROFILER
+  if (this->showProfiler) {
+    Gui_DrawProfilerOverlay((Rectangle){PANEL_X, PANEL_Y, PANEL_W, WORKSPACE_H});
+  }
+#endif
+  if (this->hoveredNode != (size_t)-1) {
+    Workspace_DrawNodeTooltip(core, this->hoveredNode, GetMousePosition());
   }
+  Gui_DrawSearchResults(this, core);
   GuiWindowFileDialog(&this->fileDialogState);
 
+  Gui_UpdateEventWaiting(this);
   EndDrawing();
 }
 
+static void Gui_UpdateEventWaiting(Gui* this) {
+  // live profiler numbers need continuous frames
+  const bool busy = this->graphNeedsToChange || this->changeProcent < 1.0 || this->redrawRequests > 0 ||
+                    this->showProfiler;
+  if (this->redrawRequests > 0) {
+    --this->redrawRequests;
+  }
+
+  // frame woken up by input event is followed by one more, so effects of that input get drawn
+  const bool waitForEvents = this->idleMode && !busy && !this->waitedForEvents;
+  if (waitForEvents && !this->waitedForEvents) {
+    EnableEventWaiting();
+  } else if (!waitForEvents && this->waitedForEvents) {
+    DisableEventWaiting();
+  }
+  this->waitedForEvents = waitForEvents;
+}
+
 static void Gui_DrawToolbar(Gui* this, Core* core) {
   const Vector2 TOOLBAR_POSITION = {.x = this->windowMargins.x, .y = this->windowMargins.y};
   const Vector2 TOOLBAR_PADDINGS = {.x = this->windowPaddings.x, .y = 0};
@@ -239,55 +451,558 @@ static void Gui_DrawToolbar(Gui* this, Core* core) {
     this->fileDialogState.windowActive = true;
   }
 
-  GuiLabel(FlowLayout_Add(&toolbarLayout, SELECTED_FILE_LABEL_W, TOOLBAR_H), this->displayedFileName);
+  if (core->loading) {
+    const float CANCEL_W = 64;
+    GuiProgressBar(FlowLayout_Add(&toolbarLayout, SELECTED_FILE_LABEL_W - CANCEL_W - TOOLBAR_PADDINGS.x, TOOLBAR_H),
+                   NULL, NULL, &core->loadingProgress, 0, 1);
+    if (GuiButton(FlowLayout_Add(&toolbarLayout, CANCEL_W, TOOLBAR_H), "CANCEL")) {
+      core->cancelLoading = true;
+    }
+  } else {
+    GuiLabel(FlowLayout_Add(&toolbarLayout, SELECTED_FILE_LABEL_W, TOOLBAR_H), this->displayedFileName);
+  }
 
   if (!this->showFrameList) {
     if (GuiButton(FlowLayout_Add(&toolbarLayout, TOOLBAR_H, TOOLBAR_H), "<")) {
-      core->currentLog = 0 == core->currentLog ? core->currentLog : core->currentLog - 1;
-      this->graphNeedsToChange = true;
+      Gui_SeekTo(this, core, 0 == core->currentLog ? core->currentLog : core->currentLog - 1);
     }
     GuiLabel(FlowLayout_Add(&toolbarLayout, 160, TOOLBAR_H), this->selectedTimestamp);
     if (GuiButton(FlowLayout_Add(&toolbarLayout, TOOLBAR_H, TOOLBAR_H), ">")) {
-      core->currentLog =
-          core->currentLog + 1 >= core->logBook.entriesSize ? core->logBook.entriesSize - 1 : core->currentLog + 1;
-      this->graphNeedsToChange = true;
+      Gui_SeekTo(this, core, core->currentLog + 1);
     }
   }
 
   GuiLabel(FlowLayout_Add(&toolbarLayout, 40, TOOLBAR_H), "Style:");
   GuiComboBox(FlowLayout_Add(&toolbarLayout, 120, TOOLBAR_H), GUI_STYLES_COMBOLIST, &this->activeStyle);
 
+  GuiLabel(FlowLayout_Add(&toolbarLayout, 32, TOOLBAR_H), "Find:");
+  this->searchBoxRect = FlowLayout_Add(&toolbarLayout, 160, TOOLBAR_H);
+  if (GuiTextBox(this->searchBoxRect, this->searchText, sizeof(this->searchText), this->searchEditMode)) {
+    this->searchEditMode = !this->searchEditMode;
+    if (this->searchEditMode) {
+      this->searchedNames = NULL;  // reopen list of results
+    }
+    if (IsKeyPressed(KEY_ENTER) && this->searchResultsSize > 0) {
+      Gui_JumpToNode(this, core, this->searchResults[0]);
+    }
+  }
+  Gui_UpdateSearchResults(this, core);
+
+  GuiLabel(FlowLayout_Add(&toolbarLayout, 36, TOOLBAR_H), "Filter:");
+  if (GuiTextBox(FlowLayout_Add(&toolbarLayout, 240, TOOLBAR_H), this->filterText, sizeof(this->filterText),
+                 this->filterEditMode)) {
+    this->filterEditMode = !this->filterEditMode;
+    if (!this->filterEditMode) {
+      Filter_Compile(&this->filter, this->filterText);
+      Gui_UpdateFilter(this, core);
+      Gui_Relayout(this, core);
+      Gui_UpdateGrouping(this, core);
+    }
+  }
+  if (this->filterText[0] != '\0') {
+    char filterStatus[80];
+    if (Filter_IsActive(&this->filter)) {
+      snprintf(filterStatus, sizeof(filterStatus), "%zu of %zu", this->filter.visibleSize,
+               core->currentGraph.nodesSize);
+    } else {
+      snprintf(filterStatus, sizeof(filterStatus), "%s", this->filter.error);
+    }
+    GuiLabel(FlowLayout_Add(&toolbarLayout, 200, TOOLBAR_H), filterStatus);
+  }
+
   FlowLayout_Destroy(&toolbarLayout);
 
   const Vector2 TOOLBAR2_POSITION = {.x = this->windowMargins.x,
                                      .y = this->windowMargins.y + TOOLBAR_H + this->windowPaddings.y};
   FlowLayout toolbar2Layout = FlowLayout_Init(TOOLBAR2_POSITION, TOOLBAR_PADDINGS);
+  GuiComboBox(FlowLayout_Add(&toolbar2Layout, 88, TOOLBAR_H), "Diagram;Timeline", &this->workspaceView);
   GuiLabel(FlowLayout_Add(&toolbar2Layout, 40, TOOLBAR_H), "Layout:");
-  GuiComboBox(FlowLayout_Add(&toolbar2Layout, 120, TOOLBAR_H), "Absolute;Relative",
+  const int prevLayout = *Workspace_PointDiagramLayout(this->workspace);
+  const int prevHops = *Workspace_PointFocusHops(this->workspace);
+  GuiComboBox(FlowLayout_Add(&toolbar2Layout, 120, TOOLBAR_H), "Absolute;Relative;Focus",
               Workspace_PointDiagramLayout(this->workspace));
+  if (*Workspace_PointDiagramLayout(this->workspace) == EDiagramLayout_Focus) {
+    GuiSpinner(FlowLayout_Add(&toolbar2Layout, 80, TOOLBAR_H), "Hops ", Workspace_PointFocusHops(this->workspace), 1,
+               FOCUS_MAX_HOPS, false);
+  }
+  if (prevLayout != *Workspace_PointDiagramLayout(this->workspace) ||
+      prevHops != *Workspace_PointFocusHops(this->workspace)) {
+    Gui_Relayout(this, core);
+  }
+
+  const int prevReachQuery = *Workspace_PointReachQuery(this->workspace);
+  GuiComboBox(FlowLayout_Add(&toolbar2Layout, 96, TOOLBAR_H), "Trace off;Blockers;Unblocks",
+              Workspace_PointReachQuery(this->workspace));
+  if (prevReachQuery != *Workspace_PointReachQuery(this->workspace) && !this->nodesStale) {
+    Workspace_UpdateHighlight(this->workspace, &core->currentGraph);
+  }
+  if (*Workspace_PointReachQuery(this->workspace) != EReach_None) {
+    char reachText[32];
+    snprintf(reachText, sizeof(reachText), "%zu nodes", Workspace_HighlightedSize(this->workspace));
+    GuiLabel(FlowLayout_Add(&toolbar2Layout, 64, TOOLBAR_H), reachText);
+  }
+
+  bool reduceEdges = Workspace_GetReduceEdges(this->workspace);
+  char reduceText[32] = "REDUCE";
+  if (reduceEdges) {
+    snprintf(reduceText, sizeof(reduceText), "REDUCED (-%zu)", Workspace_RedundantEdgesSize(this->workspace));
+  }
+  GuiToggle(FlowLayout_Add(&toolbar2Layout, reduceEdges ? 104 : 64, TOOLBAR_H), reduceText, &reduceEdges);
+  if (reduceEdges != Workspace_GetReduceEdges(this->workspace)) {
+    Workspace_SetReduceEdges(this->workspace, &core->currentGraph, reduceEdges);
+  }
+
+  char zoomText[16];
+  snprintf(zoomText, sizeof(zoomText), "Zoom: %.1f%%", Workspace_GetZoom(this->workspace) * 100);
+  GuiLabel(FlowLayout_Add(&toolbar2Layout, 90, TOOLBAR_H), zoomText);
+  if (GuiButton(FlowLayout_Add(&toolbar2Layout, 32, TOOLBAR_H), "1:1")) {
+    Workspace_SetZoom(this->workspace, 1.0);
+  }
+
+  GuiComboBox(FlowLayout_Add(&toolbar2Layout, 64, TOOLBAR_H), "SVG;DOT;JSON", &this->exportFormat);
+  if (GuiButton(FlowLayout_Add(&toolbar2Layout, 56, TOOLBAR_H), "EXPORT")) {
+    Gui_ExportSnapshot(this, core);
+  }
+
+  char issuesText[32];
+  snprintf(issuesText, sizeof(issuesText), "ISSUES (%zu)", Diagnostics_Count(&core->logBook.diagnostics));
+  GuiToggle(FlowLayout_Add(&toolbar2Layout, 96, TOOLBAR_H), issuesText, &this->showDiagnostics);
+  if (this->showDiagnostics && GuiButton(FlowLayout_Add(&toolbar2Layout, 48, TOOLBAR_H), "DUMP")) {
+    Diagnostics_Print(&core->logBook.diagnostics, stdout);
+  }
+  GuiToggle(FlowLayout_Add(&toolbar2Layout, 48, TOOLBAR_H), "STATS", &this->showStats);
+
+  const bool prevShowDiff = this->showDiff;
+  const size_t prevDiffBase = this->diffBase;
+  GuiToggle(FlowLayout_Add(&toolbar2Layout, 40, TOOLBAR_H), "DIFF", &this->showDiff);
+  if (this->showDiff && (!prevShowDiff || GuiButton(FlowLayout_Add(&toolbar2Layout, 40, TOOLBAR_H), "BASE"))) {
+    this->diffBase = core->currentLog;
+  }
+  if (prevShowDiff != this->showDiff || prevDiffBase != this->diffBase) {
+    Gui_UpdateDiff(this, core);
+  }
+  if (this->showDiff) {
+    char diffText[96];
+    snprintf(diffText, sizeof(diffText), "#%zu: +%zu -%zu ~%zu, edges +%zu -%zu", this->diffBase,
+             this->diff.nodeCounts[EDiffMark_Added], this->diff.nodeCounts[EDiffMark_Removed],
+             this->diff.nodeCounts[EDiffMark_StatusChanged], this->diff.edgeCounts[EDiffMark_Added],
+             this->diff.edgeCounts[EDiffMark_Removed]);
+    GuiLabel(FlowLayout_Add(&toolbar2Layout, 200, TOOLBAR_H), diffText);
+  }
+
+  const int prevGroupRule = this->groupRule;
+  GuiComboBox(FlowLayout_Add(&toolbar2Layout, 96, TOOLBAR_H), "No groups;Prefix;Delimiter;Regex", &this->groupRule);
+  bool groupingChanged = prevGroupRule != this->groupRule;
+  if (this->groupRule == EGroupRule_Delimiter || this->groupRule == EGroupRule_Regex) {
+    if (GuiTextBox(FlowLayout_Add(&toolbar2Layout, 120, TOOLBAR_H), this->groupPattern, sizeof(this->groupPattern),
+                   this->groupEditMode)) {
+      this->groupEditMode = !this->groupEditMode;
+      groupingChanged = groupingChanged || !this->groupEditMode;  // pattern is applied once edited
+    }
+  } else {
+    this->groupEditMode = false;
+  }
+  if (groupingChanged) {
+    Grouping_SetRule(&this->grouping, this->groupRule, this->groupPattern);
+    Gui_UpdateGrouping(this, core);
+    if (!Grouping_IsActive(&this->grouping) && this->nodesStale) {
+      Gui_LayOutNodes(this, core);
+    }
+  }
+  if (this->groupRule != EGroupRule_None) {
+    char groupsText[32] = "invalid pattern";
+    if (Grouping_IsActive(&this->grouping)) {
+      snprintf(groupsText, sizeof(groupsText), "%zu groups", Grouping_VisibleGroupsSize(&this->grouping));
+    }
+    GuiLabel(FlowLayout_Add(&toolbar2Layout, 96, TOOLBAR_H), groupsText);
+  }
+#ifdef DEPVIEW_PROFILER
+  GuiToggle(FlowLayout_Add(&toolbar2Layout, 64, TOOLBAR_H), "PROFILE", &this->showProfiler);
+#endif
+  FlowLayout_Destroy(&toolbar2Layout);
 }
 
 static void Gui_DrawWorkspacePanel(Gui* this, Core* core, const Rectangle rect) {
+  if (this->workspaceView == EWorkspaceView_Timeline) {
+    Gui_DrawTimelinePanel(this, core, rect);
+    return;
+  }
   if (this->fileDialogState.windowActive) {
     GuiSetState(STATE_DISABLED);
   }
 
-  Vector2 wsSize = Workspace_GetSpaceSize(this->workspace, &rect);
+  const bool zoomed = Gui_HandleWorkspaceZoom(this, rect);
+  const bool grouped = Grouping_IsActive(&this->grouping);
+  Vector2 wsSize = grouped ? Grouping_GetSpaceSize(&this->grouping, &rect, Workspace_GetZoom(this->workspace))
+                           : Workspace_GetSpaceSize(this->workspace, &rect);
 
+  if (zoomed) {
+    GuiLock();  // mouse wheel has been consumed by zoom, scroll panel shall not scroll with it
+  }
   GuiScrollPanel(rect, NULL, (Rectangle){.x = 0, .y = 0, .width = wsSize.x, .height = wsSize.y},
                  &this->scrollPanelScrollOffset, &this->scrollPanelView);
+  GuiUnlock();
 
   GuiSetState(STATE_NORMAL);
   BeginScissorMode(this->scrollPanelView.x, this->scrollPanelView.y,
                    this->scrollPanelView.width - this->scrollPanelBoundsOffset.x,
                    this->scrollPanelView.height - this->scrollPanelBoundsOffset.y);
+  this->hoveredNode = (size_t)-1;
   if (core->logBook.entriesSize > 0 && this->workspace) {
     Vector2 workspaceOffset = {
         .x = this->scrollPanelView.x + this->scrollPanelScrollOffset.x,
         .y = this->scrollPanelView.y + this->scrollPanelScrollOffset.y,
     };
-    Workspace_Draw(this->workspace, core, this->changeProcent, &workspaceOffset);
-    this->changeProcent = this->changeProcent + 0.02 > 1.00 ? 1.0 : this->changeProcent + 0.02;
+    if (grouped) {
+      Grouping_Draw(&this->grouping, &this->scrollPanelView, &workspaceOffset, Workspace_GetZoom(this->workspace));
+    } else {
+      Workspace_Draw(this->workspace, core, this->changeProcent, &this->scrollPanelView, &workspaceOffset);
+    }
+
+    const Vector2 mouse = GetMousePosition();
+    if (!grouped && !this->fileDialogState.windowActive && CheckCollisionPointRec(mouse, this->scrollPanelView)) {
+      this->hoveredNode = Workspace_PickNode(this->workspace, mouse, &workspaceOffset);
+      if (this->hoveredNode != (size_t)-1 && IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
+        Gui_SelectNode(this, core, this->hoveredNode);
+      }
+    }
+    const float step = fminf(GetFrameTime(), 1.0 / 30) / ANIMATION_DURATION;
+    this->changeProcent = this->changeProcent + step > 1.00 ? 1.0 : this->changeProcent + step;
+  }
+  EndScissorMode();
+}
+
+// Clicked time seeks log there, clicked name selects node, which shares Node.id with NodeStats
+static void Gui_DrawTimelinePanel(Gui* this, Core* core, const Rectangle rect) {
+  this->hoveredNode = (size_t)-1;
+  if (this->fileDialogState.windowActive) {
+    GuiSetState(STATE_DISABLED);
+  }
+  const size_t selectedNode = Workspace_GetSelectedNode(this->workspace);
+  const size_t selectedId =
+      selectedNode < core->currentGraph.nodesSize ? core->currentGraph.nodes[selectedNode].id : (size_t)-1;
+  size_t clickedId = (size_t)-1;
+  const size_t entry =
+      Timeline_Draw(&this->timeline, rect, &core->logBook, core->currentLog, selectedId, &clickedId);
+  GuiSetState(STATE_NORMAL);
+  this->changeProcent = 1.0;  // nothing is animated on timeline
+  if (entry != (size_t)-1 && entry != core->currentLog) {
+    Gui_SeekTo(this, core, entry);
+  }
+  const size_t clickedNode = clickedId != (size_t)-1 ? Graph_NodeOfId(&core->currentGraph, clickedId) : (size_t)-1;
+  if (clickedNode < core->currentGraph.nodesSize) {
+    Gui_SelectNode(this, core, clickedNode);
+  }
+}
+
+static bool Gui_HandleWorkspaceZoom(Gui* this, const Rectangle rect) {
+  const Vector2 mouse = GetMousePosition();
+  if (this->fileDialogState.windowActive || !CheckCollisionPointRec(mouse, rect) ||
+      !(IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL))) {
+    return false;
+  }
+  const float wheel = GetMouseWheelMove();
+  if (wheel == 0) {
+    return false;
+  }
+
+  // keep point of diagram under cursor in place
+  const float oldZoom = Workspace_GetZoom(this->workspace);
+  Workspace_SetZoom(this->workspace, oldZoom * powf(1.25, wheel));
+  const float ratio = Workspace_GetZoom(this->workspace) / oldZoom;
+  const Vector2 anchor = {
+      .x = mouse.x - this->scrollPanelView.x,
+      .y = mouse.y - this->scrollPanelView.y,
+  };
+  this->scrollPanelScrollOffset.x = anchor.x - (anchor.x - this->scrollPanelScrollOffset.x) * ratio;
+  this->scrollPanelScrollOffset.y = anchor.y - (anchor.y - this->scrollPanelScrollOffset.y) * ratio;
+  return true;
+}
+
+static void Gui_DrawDiagnosticsPanel(Gui* this, Core* core, const Rectangle rect) {
+  const float LINE_H = 16;
+  const Diagnostics* diagnostics = &core->logBook.diagnostics;
+  const size_t recordsSize = Diagnostics_RecordsSize(diagnostics);
+
+  char title[64];
+  snprintf(title, sizeof(title), "%zu issues, first %zu listed", Diagnostics_Count(diagnostics), recordsSize);
+  GuiScrollPanel(rect, title, (Rectangle){.x = 0, .y = 0, .width = rect.width - 15, .height = recordsSize * LINE_H},
+                 &this->diagnosticsScrollOffset, &this->diagnosticsView);
+
+  const float firstRow = -this->diagnosticsScrollOffset.y / LINE_H;
+  size_t first = firstRow > 0 ? (size_t)firstRow : 0;
+  size_t last = (size_t)((-this->diagnosticsScrollOffset.y + this->diagnosticsView.height) / LINE_H) + 1;
+  last = last > recordsSize ? recordsSize : last;
+
+  BeginScissorMode(this->diagnosticsView.x, this->diagnosticsView.y, this->diagnosticsView.width,
+                   this->diagnosticsView.height);
+  for (size_t i = first; i < last; ++i) {
+    char text[160];
+    Diagnostics_FormatRecord(Diagnostics_Record(diagnostics, i), text, sizeof(text));
+    const float y = this->diagnosticsView.y + LINE_H * i + this->diagnosticsScrollOffset.y;
+    GuiLabel((Rectangle){this->diagnosticsView.x + 4, y, this->diagnosticsView.width - 4, LINE_H}, text);
+  }
+  EndScissorMode();
+}
+
+// Snapshot is saved next to log file, named after current entry
+static void Gui_ExportSnapshot(Gui* this, Core* core) {
+  if (core->loading || core->currentGraph.nodesSize == 0 || this->logFileName[0] == '\0') {
+    return;
+  }
+  if (this->nodesStale) {
+    Gui_LayOutNodes(this, core);  // nodes are exported also while groups are shown
+  }
+  char fileName[2100];
+  snprintf(fileName, sizeof(fileName), "%s.%zu.%s", this->logFileName, core->currentLog,
+           Export_Extension(this->exportFormat));
+  if (Export_Write(fileName, this->exportFormat, &core->currentGraph, &core->logBook,
+                   Workspace_GetCoordinates(this->workspace))) {
+    printf("Exported %s\n", fileName);
+  }
+}
+
+// Results follow typed text, also when another log has been loaded meanwhile
+static void Gui_UpdateSearchResults(Gui* this, const Core* core) {
+  const NodeIndex* index = &core->logBook.nameIndex;
+  if (strcmp(this->searchText, this->searchedText) == 0 && this->searchedNames == index->names &&
+      index->names != NULL) {
+    return;
+  }
+  memcpy(this->searchedText, this->searchText, sizeof(this->searchedText));
+  this->searchedNames = index->names;
+  this->searchResultsSize =
+      NodeIndex_Search(index, this->searchText, this->searchResults, SEARCH_RESULTS_MAX);
+  Gui_ResolveSearchResults(this, core);
+}
+
+// Once per search edit and graph change, rows are drawn every frame
+static void Gui_ResolveSearchResults(Gui* this, const Core* core) {
+  for (size_t i = 0; i < this->searchResultsSize; ++i) {
+    this->searchResultNodes[i] = Graph_NodeIndex(&core->currentGraph, this->searchResults[i]);
+  }
+}
+
+static void Gui_DrawSearchResults(Gui* this, Core* core) {
+  if (this->searchResultsSize == 0 || this->fileDialogState.windowActive) {
+    return;
+  }
+  const float ROW_H = this->toolbarHeight;
+  const Rectangle list = {this->searchBoxRect.x, this->searchBoxRect.y, this->searchBoxRect.width,
+                          (this->searchResultsSize + 1) * ROW_H};
+  if (!this->searchEditMode && IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
+      !CheckCollisionPointRec(GetMousePosition(), list)) {
+    this->searchResultsSize = 0;  // clicked elsewhere, list comes back with next edit
+    return;
+  }
+  for (size_t i = 0; i < this->searchResultsSize; ++i) {
+    const size_t nodeName = this->searchResults[i];
+    const Rectangle row = {this->searchBoxRect.x, this->searchBoxRect.y + (i + 1) * ROW_H, this->searchBoxRect.width,
+                           ROW_H};
+    // names of nodes absent from current snapshot are listed, but cannot be jumped to
+    if (this->searchResultNodes[i] == (size_t)-1) {
+      GuiSetState(STATE_DISABLED);
+    }
+    if (GuiButton(row, LogBook_GetNodeName(&core->logBook, nodeName))) {
+      Gui_JumpToNode(this, core, nodeName);
+    }
+    GuiSetState(STATE_NORMAL);
+  }
+}
+
+// Selects node and scrolls workspace panel so the node is in the middle of it
+static void Gui_JumpToNode(Gui* this, Core* core, size_t nodeName) {
+  const size_t nodeIndex = Graph_NodeIndex(&core->currentGraph, nodeName);
+  if (nodeIndex == (size_t)-1) {
+    return;
+  }
+  this->searchResultsSize = 0;
+  this->searchEditMode = false;
+  Gui_SelectNode(this, core, nodeIndex);
+  if (this->nodesStale) {
+    return;
+  }
+  const Vector2 center = Workspace_GetNodeCenter(this->workspace, nodeIndex);
+  this->scrollPanelScrollOffset.x = fminf(0, this->scrollPanelView.width / 2 - center.x);
+  this->scrollPanelScrollOffset.y = fminf(0, this->scrollPanelView.height / 2 - center.y);
+  Timeline_ScrollToNode(&this->timeline, core->currentGraph.nodes[nodeIndex].id);
+}
+
+static void Gui_SelectNode(Gui* this, Core* core, size_t nodeIndex) {
+  const bool changed = Workspace_GetSelectedNode(this->workspace) != nodeIndex;
+  Workspace_SetSelectedNode(this->workspace, &core->currentGraph, nodeIndex);
+  if (this->nodesStale) {
+    return;  // selection is kept by id until nodes are laid out
+  } else if (changed && Workspace_LayoutFollowsSelection(this->workspace)) {
+    Gui_Relayout(this, core);
+  } else if (changed) {
+    Workspace_UpdateHighlight(this->workspace, &core->currentGraph);
+  }
+}
+
+// Diff follows current entry, it is computed from entries between it and base only
+static void Gui_UpdateDiff(Gui* this, const Core* core) {
+  if (!this->showDiff || core->logBook.entriesSize == 0) {
+    Workspace_SetDiff(this->workspace, NULL);
+    return;
+  }
+  Diff_Build(&this->diff, &core->logBook, this->diffBase, core->currentLog);
+  Workspace_SetDiff(this->workspace, &this->diff);
+}
+
+// Nodes hidden by filter take no place in layout, so it has to be evaluated before graph is laid out
+static void Gui_UpdateFilter(Gui* this, const Core* core) {
+  if (!Filter_IsActive(&this->filter) || core->logBook.entriesSize <= core->currentLog) {
+    Workspace_SetFilter(this->workspace, NULL);
+    return;
+  }
+  const time_t now = core->logBook.entries[core->currentLog].timestamp;
+  Workspace_SetFilter(this->workspace, Filter_Evaluate(&this->filter, &core->currentGraph, &core->logBook, now));
+}
+
+// Groups of nodes already seen are kept, only aggregates and layout of groups follow current graph
+static void Gui_UpdateGrouping(Gui* this, const Core* core) {
+  if (!Grouping_IsActive(&this->grouping) || core->logBook.entriesSize == 0) {
+    return;
+  }
+  Grouping_Update(&this->grouping, &core->currentGraph, &core->logBook, Workspace_GetFilter(this->workspace));
+}
+
+// Nodes are laid out for current graph, as long as grouping is active only groups are
+static void Gui_LayOutNodes(Gui* this, Core* core) {
+  Workspace_BuildLayout(this->workspace, &core->currentGraph);
+  this->nodesStale = false;
+}
+
+// Layout is rebuilt at once, without waiting for next graph change, and animated from previous one
+static void Gui_Relayout(Gui* this, Core* core) {
+  if (core->currentGraph.nodesSize == 0 || this->nodesStale) {
+    return;
+  }
+  Workspace_Relayout(this->workspace, &core->currentGraph);
+  this->changeProcent = 0.0;
+}
+
+// Longest lifetimes of nodes on the left, sorted by chosen column, and histograms of time in status on the right
+static void Gui_DrawStatsPanel(Gui* this, Core* core, const Rectangle rect) {
+  const float LINE_H = 16;
+  const float HEADER_H = 20;
+  const float NAME_W = 160;
+  const float COLUMN_W = 80;
+  const NodeStats* stats = &core->logBook.stats;
+  if (this->statsTopKey != this->statsKey || this->statsTopChanges != stats->changes) {
+    this->statsTopSize = NodeStats_Top(stats, this->statsKey, this->statsTop, STATS_TOP_MAX);
+    this->statsTopKey = this->statsKey;
+    this->statsTopChanges = stats->changes;
+  }
+
+  const Rectangle listRect = {rect.x, rect.y, fminf(NAME_W + NODESTATS_KEYS * COLUMN_W + 20, rect.width * 0.6),
+                              rect.height};
+  GuiLabel((Rectangle){listRect.x, listRect.y, NAME_W, HEADER_H}, "Longest:");
+  GuiToggleGroup((Rectangle){listRect.x + NAME_W, listRect.y, COLUMN_W, HEADER_H}, "waiting;ongoing;finished;lifetime",
+                 &this->statsKey);
+
+  char title[64];
+  snprintf(title, sizeof(title), "%zu of %zu nodes", this->statsTopSize, stats->nodesSize);
+  const Rectangle scrollRect = {listRect.x, listRect.y + HEADER_H + 2, listRect.width, listRect.height - HEADER_H - 2};
+  GuiScrollPanel(scrollRect, title,
+                 (Rectangle){.x = 0, .y = 0, .width = scrollRect.width - 15, .height = this->statsTopSize * LINE_H},
+                 &this->statsScrollOffset, &this->statsView);
+
+  const float firstRow = -this->statsScrollOffset.y / LINE_H;
+  size_t first = firstRow > 0 ? (size_t)firstRow : 0;
+  size_t last = (size_t)((-this->statsScrollOffset.y + this->statsView.height) / LINE_H) + 1;
+  last = last > this->statsTopSize ? this->statsTopSize : last;
+
+  BeginScissorMode(this->statsView.x, this->statsView.y, this->statsView.width, this->statsView.height);
+  for (size_t i = first; i < last; ++i) {
+    const size_t node = this->statsTop[i];
+    const float y = this->statsView.y + LINE_H * i + this->statsScrollOffset.y;
+    // clicking name jumps to node, as long as it is present in current snapshot
+    if (GuiLabelButton((Rectangle){this->statsView.x + 4, y, NAME_W - 4, LINE_H},
+                       LogBook_GetNodeName(&core->logBook, stats->nodeNames[node]))) {
+      Gui_JumpToNode(this, core, stats->nodeNames[node]);
+    }
+    for (int key = 0; key < NODESTATS_KEYS; ++key) {
+      char duration[32];
+      NodeStats_FormatDuration(NodeStats_Duration(stats, node, key), duration, sizeof(duration));
+      GuiLabel((Rectangle){this->statsView.x + NAME_W + key * COLUMN_W, y, COLUMN_W, LINE_H}, duration);
+    }
   }
   EndScissorMode();
+
+  const float PADDING = this->windowPaddings.x;
+  const Rectangle histogramsRect = {listRect.x + listRect.width + PADDING, rect.y,
+                                    rect.width - listRect.width - PADDING, rect.height};
+  if (histogramsRect.width < 100) {
+    return;
+  }
+  GuiGroupBox(histogramsRect, "Time in status, nodes per duration");
+  const float HISTOGRAM_H = (histogramsRect.height - 3 * PADDING) / 2;
+  Gui_DrawStatsHistogram(stats, EStatus_Waiting, Workspace_StatusColor(EStatus_Waiting, false),
+                         (Rectangle){histogramsRect.x + PADDING, histogramsRect.y + 2 * PADDING,
+                                     histogramsRect.width - 2 * PADDING, HISTOGRAM_H});
+  Gui_DrawStatsHistogram(stats, EStatus_Ongoing, Workspace_StatusColor(EStatus_Ongoing, false),
+                         (Rectangle){histogramsRect.x + PADDING, histogramsRect.y + 2 * PADDING + HISTOGRAM_H,
+                                     histogramsRect.width - 2 * PADDING, HISTOGRAM_H});
+}
+
+// Buckets grow twice, ticks mark roughly a second, a minute, an hour and a day
+static void Gui_DrawStatsHistogram(const NodeStats* stats, int status, Color color, const Rectangle rect) {
+  const float LABEL_W = 100;
+  const float TICKS_H = 14;
+  const size_t* counts = stats->histograms[status];
+  size_t max = 0;
+  for (size_t b = 0; b < NODESTATS_BUCKETS; ++b) {
+    max = counts[b] > max ? counts[b] : max;
+  }
+  char label[48];
+  snprintf(label, sizeof(label), "%s\nmax %zu", LogBook_StatusName(status), max);
+  GuiLabel((Rectangle){rect.x, rect.y, LABEL_W, rect.height - TICKS_H}, label);
+
+  const float barsX = rect.x + LABEL_W;
+  const float barW = (rect.width - LABEL_W) / NODESTATS_BUCKETS;
+  const float barsH = rect.height - TICKS_H;
+  for (size_t b = 0; max > 0 && b < NODESTATS_BUCKETS; ++b) {
+    const float h = barsH * counts[b] / max;
+    DrawRectangleRec((Rectangle){barsX + b * barW + 1, rect.y + barsH - h, barW - 2, h}, color);
+  }
+  const struct {
+    size_t bucket;
+    const char* text;
+  } TICKS[] = {{1, "1s"}, {7, "1m"}, {13, "1h"}, {17, "1d"}};
+  for (size_t i = 0; i < sizeof(TICKS) / sizeof(TICKS[0]); ++i) {
+    GuiLabel((Rectangle){barsX + TICKS[i].bucket * barW, rect.y + barsH, 24, TICKS_H}, TICKS[i].text);
+  }
+}
+
+#ifdef DEPVIEW_PROFILER
+static void Gui_DrawProfilerOverlay(const Rectangle rect) {
+  const float LINE_H = 16;
+  const float PADDING = 6;
+  const float OVERLAY_W = 320;
+  const Rectangle box = {rect.x + rect.width - OVERLAY_W - PADDING, rect.y + PADDING, OVERLAY_W,
+                         (EPhase_Size + 3) * LINE_H + 2 * PADDING};
+  DrawRectangleRec(box, Fade(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)), 0.85));
+  DrawRectangleLinesEx(box, 1, GetColor(GuiGetStyle(DEFAULT, LINE_COLOR)));
+
+  char line[96];
+  Rectangle lineRect = {box.x + PADDING, box.y + PADDING, OVERLAY_W - 2 * PADDING, LINE_H};
+  snprintf(line, sizeof(line), "%-15s %7s %7s %7s", "phase [ms]", "last", "avg", "max");
+  GuiLabel(lineRect, line);
+  for (EPhase phase = 0; phase < EPhase_Size; ++phase) {
+    const ProfilerStats stats = Profiler_GetStats(phase);
+    snprintf(line, sizeof(line), "%-15s %7.2f %7.2f %7.2f", Profiler_PhaseName(phase), stats.lastMs,
+             stats.averageMs, stats.maxMs);
+    lineRect.y += LINE_H;
+    GuiLabel(lineRect, line);
+  }
+  snprintf(line, sizeof(line), "nodes %zu  edges %zu  entries %zu", Profiler_GetCounter(ECounter_Nodes),
+           Profiler_GetCounter(ECounter_Edges), Profiler_GetCounter(ECounter_Entries));
+  lineRect.y += LINE_H;
+  GuiLabel(lineRect, line);
+  snprintf(line, sizeof(line), "fps %d  dropped events %zu", GetFPS(), Profiler_GetDropped());
+  lineRect.y += LINE_H;
+  GuiLabel(lineRect, line);
 }
+#endif
@@ -15,7 +15,9 @@ void Gui_Loop(Gui* gui, Core* core);
 void Gui_TriggerGraphChange(Gui* gui);
 
 void Gui_SetActiveStyle(Gui* gui, int activeStyle);
-void Gui_SetNewFileName(Gui* gui, char* fileName);
+void Gui_SetNewFileName(Gui* gui, const char* fileName);
+void Gui_SetFrameRate(Gui* gui, int targetFps, bool idleMode);
+void Gui_RequestRedraw(Gui* gui);
 void Gui_InitWindow(Gui* gui, char* title);
 void Gui_Draw(Gui* app, Core* core);
 bool Gui_ShouldWindowClose();
@@ -0,0 +1,166 @@
+#define _XOPEN_SOURCE 500
+
+#include "Headless.h"
+#include "Export.h"
+#include "Graph.h"
+#include "LogBook.h"
+#include "Workspace.h"
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static bool Headless_ResolveEntry(const LogBook* logBook, const char* at, size_t* entry);
+static void Headless_DumpSnapshot(const Graph* graph, const LogBook* logBook, size_t entry, EDumpFormat format);
+static void Headless_DumpSummary(const Graph* graph, const LogBook* logBook, size_t entry, EDumpFormat format);
+static int Headless_Export(const Graph* graph, const LogBook* logBook, const char* fileName);
+
+int Headless_Run(const HeadlessQuery* query) {
+  if (query->sourcesSize == 0) {
+    fprintf(stderr, "Headless mode requires log file path\n");
+    return 2;
+  }
+
+  const char* filePath = query->sources[0].fileName;
+  LogBook logBook = LogBook_Init();
+  logBook.diagnostics.verbosity = query->verbosity;
+  if (!LogBook_LoadMerged(&logBook, query->sources, query->sourcesSize, NULL)) {
+    LogBook_Destroy(&logBook);
+    return 1;
+  }
+  if (logBook.entriesSize == 0) {
+    fprintf(stderr, "No entries in %s\n", filePath);
+    LogBook_Destroy(&logBook);
+    return 1;
+  }
+
+  int result = 0;
+  if (query->every > 0) {
+    // single replay pass, state is printed on the way
+    if (query->format == EDumpFormat_Text) {
+      printf("entry\ttimestamp\tnodes\tedges\twaiting\tongoing\tfinished\n");
+    }
+    Graph graph = Graph_Make(&logBook);
+    Graph_SetRetention(&graph, query->retention);
+    for (size_t i = 0; i < logBook.entriesSize; ++i) {
+      Graph_Apply(&graph, &logBook, &logBook.entries[i]);
+      if (i % query->every == 0 || i + 1 == logBook.entriesSize) {
+        Headless_DumpSummary(&graph, &logBook, i, query->format);
+      }
+    }
+    Graph_Destroy(&graph);
+  } else {
+    size_t entry = logBook.entriesSize - 1;
+    if (query->at && !Headless_ResolveEntry(&logBook, query->at, &entry)) {
+      fprintf(stderr, "Cannot find entry '%s' in %s\n", query->at, filePath);
+      result = 2;
+    } else {
+      Graph graph = Graph_InitRetaining(&logBook, entry, query->retention);
+      if (query->exportFile) {
+        result = Headless_Export(&graph, &logBook, query->exportFile);
+      } else {
+        Headless_DumpSnapshot(&graph, &logBook, entry, query->format);
+      }
+      Graph_Destroy(&graph);
+    }
+  }
+
+  LogBook_Destroy(&logBook);
+  return result;
+}
+
+// Digits only select entry by index, anything else is parsed as timestamp and selects last entry not later than it
+static bool Headless_ResolveEntry(const LogBook* logBook, const char* at, size_t* entry) {
+  const char* it = at;
+  while (isdigit((unsigned char)*it)) {
+    ++it;
+  }
+  if (it != at && *it == '\0') {
+    const size_t index = strtoull(at, NULL, 10);
+    if (index >= logBook->entriesSize) {
+      return false;
+    }
+    *entry = index;
+    return true;
+  }
+
+  struct tm tm;
+  memset(&tm, 0, sizeof(tm));
+  const char* parsedEnd = strptime(at, "%Y-%m-%dT%H:%M:%S%z", &tm);
+  if (parsedEnd == NULL || *parsedEnd != '\0') {
+    return false;
+  }
+  const size_t found = LogBook_FindEntry(logBook, mktime(&tm));
+  if (found == (size_t)-1) {
+    return false;
+  }
+  *entry = found;
+  return true;
+}
+
+static void Headless_DumpSnapshot(const Graph* graph, const LogBook* logBook, size_t entry, EDumpFormat format) {
+  const time_t timestamp = logBook->entries[entry].timestamp;
+  if (format == EDumpFormat_Text) {
+    printf("entry %zu timestamp %ld\n", entry, (long)timestamp);
+    printf("nodes %zu\n", graph->nodesSize);
+    for (const Node* node = graph->nodes; node < graph->nodes + graph->nodesSize; ++node) {
+      printf("  %s %s\n", LogBook_GetNodeName(logBook, node->nodeName), LogBook_StatusName(node->status));
+    }
+    printf("edges %zu\n", graph->edgesSize);
+    for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+      printf("  %s -> %s\n", LogBook_GetNodeName(logBook, graph->nodes[edge->source].nodeName),
+             LogBook_GetNodeName(logBook, graph->nodes[edge->destination].nodeName));
+    }
+    return;
+  }
+
+  printf("{\"entry\":%zu,\"timestamp\":%ld,\n\"nodes\":[", entry, (long)timestamp);
+  for (const Node* node = graph->nodes; node < graph->nodes + graph->nodesSize; ++node) {
+    printf(node == graph->nodes ? "\n{\"name\":" : ",\n{\"name\":");
+    Export_WriteJsonString(stdout, LogBook_GetNodeName(logBook, node->nodeName));
+    printf(",\"status\":\"%s\"}", LogBook_StatusName(node->status));
+  }
+  printf("],\n\"edges\":[");
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    printf(edge == graph->edges ? "\n{\"source\":" : ",\n{\"source\":");
+    Export_WriteJsonString(stdout, LogBook_GetNodeName(logBook, graph->nodes[edge->source].nodeName));
+    printf(",\"destination\":");
+    Export_WriteJsonString(stdout, LogBook_GetNodeName(logBook, graph->nodes[edge->destination].nodeName));
+    printf("}");
+  }
+  printf("]}\n");
+}
+
+// One line per entry: tab separated columns or JSON Lines
+static void Headless_DumpSummary(const Graph* graph, const LogBook* logBook, size_t entry, EDumpFormat format) {
+  const long timestamp = logBook->entries[entry].timestamp;
+  const size_t* counts = graph->statusCounts;
+  if (format == EDumpFormat_Text) {
+    printf("%zu\t%ld\t%zu\t%zu\t%zu\t%zu\t%zu\n", entry, timestamp, graph->nodesSize, graph->edgesSize,
+           counts[EStatus_Waiting], counts[EStatus_Ongoing], counts[EStatus_Finished]);
+  } else {
+    printf("{\"entry\":%zu,\"timestamp\":%ld,\"nodes\":%zu,\"edges\":%zu,\"waiting\":%zu,\"ongoing\":%zu,"
+           "\"finished\":%zu}\n",
+           entry, timestamp, graph->nodesSize, graph->edgesSize, counts[EStatus_Waiting], counts[EStatus_Ongoing],
+           counts[EStatus_Finished]);
+  }
+}
+
+// Same layout as default diagram view of the window
+static int Headless_Export(const Graph* graph, const LogBook* logBook, const char* fileName) {
+  EExportFormat format;
+  if (!Export_FormatFromFileName(fileName, &format)) {
+    fprintf(stderr, "Unknown export format of %s, use .svg, .dot or .json\n", fileName);
+    return 2;
+  }
+  Workspace* workspace = malloc(Workspace_SizeOf());
+  Workspace_Init(workspace);
+  Workspace_BuildLayout(workspace, graph);
+  const bool exported = Export_Write(fileName, format, graph, logBook, Workspace_GetCoordinates(workspace));
+  Workspace_Destroy(workspace);
+  free(workspace);
+  return exported ? 0 : 1;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Diagnostics.h"
+#include "Graph.h"
+
+#include <stddef.h>
+
+typedef enum { EDumpFormat_Text, EDumpFormat_Json } EDumpFormat;
+
+typedef struct HeadlessQuery {
+  const LogSource* sources;  // logs merged into one
+  size_t sourcesSize;
+  const char* at;  // entry index or timestamp in log format, NULL means last entry
+  EDumpFormat format;
+  size_t every;  // when non zero, summary of every N-th entry is printed instead of single snapshot
+  const char* exportFile;  // when set, snapshot is exported to this file instead of being printed
+  Retention retention;     // finished nodes kept in graph
+  EVerbosity verbosity;
+} HeadlessQuery;
+
+// Loads log and prints query result to stdout without opening a window. Returns process exit code.
+int Headless_Run(const HeadlessQuery* query);
@@ -0,0 +1,466 @@
+#include "Inflate.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void Inflate_Decode(Inflate* this, size_t limit);
+static void Inflate_BeginBlock(Inflate* this);
+static void Inflate_BuildFixed(Inflate* this);
+static void Inflate_BuildDynamic(Inflate* this);
+static bool Inflate_BuildCode(InflateCode* code, const uint8_t* lengths, size_t lengthsSize);
+static int Inflate_Symbol(Inflate* this, const InflateCode* code);
+static void Inflate_Put(Inflate* this, uint8_t byte);
+static void Inflate_EndMember(Inflate* this);
+static bool Inflate_ReadHeader(Inflate* this);
+static uint32_t Inflate_Bits(Inflate* this, int count);
+static int Inflate_Byte(Inflate* this);
+static int Inflate_PeekByte(Inflate* this);
+static void Inflate_Fail(Inflate* this, const char* error);
+static void Inflate_UpdateCheck(Inflate* this);
+
+static const uint16_t LENGTH_BASES[] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                        31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTH_EXTRA[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                       2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DISTANCE_BASES[] = {1,    2,    3,    4,    5,    7,    9,    13,    17,    25,
+                                          33,   49,   65,   97,   129,  193,  257,  385,   513,   769,
+                                          1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DISTANCE_EXTRA[] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                         6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint8_t CODE_LENGTHS_ORDER[] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+// Looks at first bytes and rewinds file
+EInflateFormat Inflate_Detect(FILE* file) {
+  uint8_t magic[2] = {0, 0};
+  const size_t read = fread(magic, 1, 2, file);
+  rewind(file);
+  if (read < 2) {
+    return EInflateFormat_None;
+  }
+  if (magic[0] == 0x1f && magic[1] == 0x8b) {
+    return EInflateFormat_Gzip;
+  }
+  // deflate method, window of at most 32 KiB, no preset dictionary and header check. Text hardly passes all of it.
+  if ((magic[0] & 0x0f) == 8 && (magic[0] >> 4) <= 7 && !(magic[1] & 0x20) && (magic[0] * 256 + magic[1]) % 31 == 0) {
+    return EInflateFormat_Zlib;
+  }
+  return EInflateFormat_None;
+}
+
+Inflate Inflate_Init(FILE* file, EInflateFormat format) {
+  Inflate this = {
+      .file = file,
+      .format = format,
+      .input = malloc(INFLATE_INPUT_SIZE),
+      .inputBegin = 0,
+      .inputEnd = 0,
+      .bits = 0,
+      .bitsSize = 0,
+      .window = malloc(INFLATE_WINDOW_SIZE),
+      .written = 0,
+      .read = 0,
+      .checked = 0,
+      .memberSize = 0,
+      .inBlock = false,
+      .lastBlock = false,
+      .finished = false,
+      .blockType = 0,
+      .storedLeft = 0,
+      .copyLeft = 0,
+      .copyDistance = 0,
+      .check = format == EInflateFormat_Zlib ? 1 : 0,
+      .error = NULL,
+  };
+  if (this.input == NULL || this.window == NULL) {
+    perror("Cannot malloc memory for Inflate");
+    exit(10);
+  }
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = crc & 1 ? 0xedb88320 ^ (crc >> 1) : crc >> 1;
+    }
+    this.crcTable[i] = crc;
+  }
+  this.finished = !Inflate_ReadHeader(&this);
+  return this;
+}
+
+void Inflate_Destroy(Inflate* this) {
+  free(this->input);
+  this->input = NULL;
+  free(this->window);
+  this->window = NULL;
+}
+
+// Same as fgets, but on decompressed content. NULL at the end of stream or once it turned out broken.
+char* Inflate_Gets(Inflate* this, char* line, size_t size) {
+  size_t lineSize = 0;
+  while (lineSize + 1 < size) {
+    if (this->read == this->written) {
+      // at most half of window, so bytes not read yet never overwrite history still referred to
+      Inflate_Decode(this, INFLATE_WINDOW_SIZE / 2);
+      Inflate_UpdateCheck(this);
+      if (this->read == this->written) {
+        break;
+      }
+    }
+    const char c = this->window[this->read++ % INFLATE_WINDOW_SIZE];
+    line[lineSize++] = c;
+    if (c == '\n') {
+      break;
+    }
+  }
+  if (lineSize == 0 || (this->error && line[lineSize - 1] != '\n')) {
+    return NULL;  // line cut by damage is not passed on
+  }
+  line[lineSize] = '\0';
+  return line;
+}
+
+static void Inflate_Decode(Inflate* this, size_t limit) {
+  const size_t begin = this->written;
+  while (this->written - begin < limit && !this->finished) {
+    if (this->copyLeft > 0) {
+      Inflate_Put(this, this->window[(this->written - this->copyDistance) % INFLATE_WINDOW_SIZE]);
+      --this->copyLeft;
+    } else if (!this->inBlock) {
+      if (this->lastBlock) {
+        Inflate_EndMember(this);
+      } else {
+        Inflate_BeginBlock(this);
+      }
+    } else if (this->blockType == 0) {
+      if (this->storedLeft == 0) {
+        this->inBlock = false;
+        continue;
+      }
+      const int byte = Inflate_Byte(this);
+      if (byte >= 0) {
+        Inflate_Put(this, byte);
+        --this->storedLeft;
+      }
+    } else {
+      const int symbol = Inflate_Symbol(this, &this->lengths);
+      if (symbol < 0) {
+        continue;
+      } else if (symbol < 256) {
+        Inflate_Put(this, symbol);
+      } else if (symbol == 256) {
+        this->inBlock = false;
+      } else if (symbol - 257 >= (int)sizeof(LENGTH_BASES) / (int)sizeof(LENGTH_BASES[0])) {
+        Inflate_Fail(this, "invalid length code");
+      } else {
+        const size_t length = LENGTH_BASES[symbol - 257] + Inflate_Bits(this, LENGTH_EXTRA[symbol - 257]);
+        const int distanceSymbol = Inflate_Symbol(this, &this->distances);
+        if (distanceSymbol < 0 || distanceSymbol >= 30) {
+          Inflate_Fail(this, "invalid distance code");
+          continue;
+        }
+        const size_t distance = DISTANCE_BASES[distanceSymbol] + Inflate_Bits(this, DISTANCE_EXTRA[distanceSymbol]);
+        if (distance > this->memberSize) {
+          Inflate_Fail(this, "distance too far back");
+          continue;
+        }
+        this->copyLeft = length;
+        this->copyDistance = distance;
+      }
+    }
+  }
+}
+
+static void Inflate_BeginBlock(Inflate* this) {
+  this->lastBlock = Inflate_Bits(this, 1);
+  this->blockType = Inflate_Bits(this, 2);
+  this->inBlock = true;
+  switch (this->blockType) {
+    case 0: {
+      this->bits = 0;  // rest of current byte is skipped
+      this->bitsSize = 0;
+      const uint32_t length = Inflate_Bits(this, 16);
+      const uint32_t complement = Inflate_Bits(this, 16);
+      if (length != (~complement & 0xffff)) {
+        Inflate_Fail(this, "stored block length does not match its complement");
+      }
+      this->storedLeft = length;
+      break;
+    }
+    case 1:
+      Inflate_BuildFixed(this);
+      break;
+    case 2:
+      Inflate_BuildDynamic(this);
+      break;
+    default:
+      Inflate_Fail(this, "invalid block type");
+  }
+}
+
+static void Inflate_BuildFixed(Inflate* this) {
+  uint8_t lengths[INFLATE_MAX_CODES];
+  memset(lengths, 8, 144);
+  memset(lengths + 144, 9, 256 - 144);
+  memset(lengths + 256, 7, 280 - 256);
+  memset(lengths + 280, 8, INFLATE_MAX_CODES - 280);
+  Inflate_BuildCode(&this->lengths, lengths, INFLATE_MAX_CODES);
+  memset(lengths, 5, 30);
+  Inflate_BuildCode(&this->distances, lengths, 30);
+}
+
+// Code lengths of both codes are themselves Huffman coded, with run lengths
+static void Inflate_BuildDynamic(Inflate* this) {
+  const size_t lengthsSize = Inflate_Bits(this, 5) + 257;
+  const size_t distancesSize = Inflate_Bits(this, 5) + 1;
+  const size_t codeLengthsSize = Inflate_Bits(this, 4) + 4;
+  if (lengthsSize > 286 || distancesSize > 30) {
+    Inflate_Fail(this, "too many length or distance codes");
+    return;
+  }
+  uint8_t lengths[INFLATE_MAX_CODES + 32];
+  memset(lengths, 0, sizeof(lengths));
+  for (size_t i = 0; i < codeLengthsSize; ++i) {
+    lengths[CODE_LENGTHS_ORDER[i]] = Inflate_Bits(this, 3);
+  }
+  InflateCode codeLengths;
+  if (!Inflate_BuildCode(&codeLengths, lengths, 19)) {
+    Inflate_Fail(this, "invalid code lengths code");
+    return;
+  }
+  memset(lengths, 0, sizeof(lengths));
+  size_t i = 0;
+  while (i < lengthsSize + distancesSize && !this->finished) {
+    const int symbol = Inflate_Symbol(this, &codeLengths);
+    size_t repeat = 0;
+    uint8_t length = 0;
+    if (symbol < 0) {
+      return;
+    } else if (symbol < 16) {
+      lengths[i++] = symbol;
+      continue;
+    } else if (symbol == 16) {
+      if (i == 0) {
+        Inflate_Fail(this, "repeated length without previous one");
+        return;
+      }
+      length = lengths[i - 1];
+      repeat = 3 + Inflate_Bits(this, 2);
+    } else if (symbol == 17) {
+      repeat = 3 + Inflate_Bits(this, 3);
+    } else {
+      repeat = 11 + Inflate_Bits(this, 7);
+    }
+    if (i + repeat > lengthsSize + distancesSize) {
+      Inflate_Fail(this, "too many code lengths");
+      return;
+    }
+    memset(lengths + i, length, repeat);
+    i += repeat;
+  }
+  if (lengths[256] == 0) {
+    Inflate_Fail(this, "no end of block code");
+    return;
+  }
+  if (!Inflate_BuildCode(&this->lengths, lengths, lengthsSize) ||
+      !Inflate_BuildCode(&this->distances, lengths + lengthsSize, distancesSize)) {
+    Inflate_Fail(this, "invalid literal or distance code");
+  }
+}
+
+// False when lengths oversubscribe codes. Incomplete codes are accepted, their missing codes fail in Inflate_Symbol.
+static bool Inflate_BuildCode(InflateCode* code, const uint8_t* lengths, size_t lengthsSize) {
+  memset(code->counts, 0, sizeof(code->counts));
+  for (size_t i = 0; i < lengthsSize; ++i) {
+    ++code->counts[lengths[i]];
+  }
+  int left = 1;
+  for (int length = 1; length < 16; ++length) {
+    left = 2 * left - code->counts[length];
+    if (left < 0) {
+      return false;
+    }
+  }
+  uint16_t offsets[16];
+  offsets[1] = 0;
+  for (int length = 1; length < 15; ++length) {
+    offsets[length + 1] = offsets[length] + code->counts[length];
+  }
+  for (size_t i = 0; i < lengthsSize; ++i) {
+    if (lengths[i] != 0) {
+      code->symbols[offsets[lengths[i]]++] = i;
+    }
+  }
+  return true;
+}
+
+// Canonical codes of one length are consecutive, so code is compared with the range of each length in turn
+static int Inflate_Symbol(Inflate* this, const InflateCode* code) {
+  int value = 0;
+  int first = 0;
+  int index = 0;
+  for (int length = 1; length < 16; ++length) {
+    value |= Inflate_Bits(this, 1);
+    const int count = code->counts[length];
+    if (value - first < count) {
+      return code->symbols[index + value - first];
+    }
+    index += count;
+    first = (first + count) << 1;
+    value <<= 1;
+  }
+  Inflate_Fail(this, "invalid Huffman code");
+  return -1;
+}
+
+static void Inflate_Put(Inflate* this, uint8_t byte) {
+  this->window[this->written++ % INFLATE_WINDOW_SIZE] = byte;
+  ++this->memberSize;
+}
+
+// Checks trailer, gzip file can hold several members one after another
+static void Inflate_EndMember(Inflate* this) {
+  this->bits = 0;
+  this->bitsSize = 0;
+  Inflate_UpdateCheck(this);
+  if (this->format == EInflateFormat_Zlib) {
+    uint32_t adler = 0;  // big endian
+    for (int i = 0; i < 4; ++i) {
+      adler = adler << 8 | Inflate_Bits(this, 8);
+    }
+    if (!this->finished && adler != this->check) {
+      Inflate_Fail(this, "Adler-32 does not match");
+    }
+    this->finished = true;
+    return;
+  }
+  const uint32_t crc = Inflate_Bits(this, 16);  // little endian, bits are taken from lowest
+  const uint32_t crcHigh = Inflate_Bits(this, 16);
+  const uint32_t size = Inflate_Bits(this, 16);
+  const uint32_t sizeHigh = Inflate_Bits(this, 16);
+  if (!this->finished && (crc | crcHigh << 16) != (this->check ^ 0xffffffff)) {
+    Inflate_Fail(this, "CRC-32 does not match");
+  } else if (!this->finished && (size | sizeHigh << 16) != (uint32_t)this->memberSize) {
+    Inflate_Fail(this, "length does not match");
+  }
+  if (!this->finished && Inflate_PeekByte(this) >= 0) {
+    this->finished = !Inflate_ReadHeader(this);
+  } else {
+    this->finished = true;
+  }
+}
+
+// False when stream cannot be decoded
+static bool Inflate_ReadHeader(Inflate* this) {
+  this->inBlock = false;
+  this->lastBlock = false;
+  this->memberSize = 0;
+  if (this->format == EInflateFormat_Zlib) {
+    const int method = Inflate_Byte(this);
+    const int flags = Inflate_Byte(this);
+    if (method < 0 || flags < 0 || (method & 0x0f) != 8 || (flags & 0x20)) {
+      Inflate_Fail(this, "unsupported zlib header");
+    }
+    this->check = 1;
+    return this->error == NULL;
+  }
+  const int magic0 = Inflate_Byte(this);
+  const int magic1 = Inflate_Byte(this);
+  const int method = Inflate_Byte(this);
+  const int flags = Inflate_Byte(this);
+  for (int i = 0; i < 6; ++i) {  // time, extra flags and system
+    Inflate_Byte(this);
+  }
+  if (magic0 != 0x1f || magic1 != 0x8b || method != 8) {
+    Inflate_Fail(this, "unsupported gzip header");
+    return false;
+  }
+  if (flags & 0x04) {  // extra field
+    const int extraSize = Inflate_Byte(this);
+    const int extraSizeHigh = Inflate_Byte(this);
+    for (int i = 0; i < (extraSize | extraSizeHigh << 8) && this->error == NULL; ++i) {
+      Inflate_Byte(this);
+    }
+  }
+  for (int field = 0x08; field <= 0x10; field <<= 1) {  // zero terminated name and comment
+    if (flags & field) {
+      int c = 0;
+      do {
+        c = Inflate_Byte(this);
+      } while (c > 0);
+    }
+  }
+  if (flags & 0x02) {  // header CRC
+    Inflate_Byte(this);
+    Inflate_Byte(this);
+  }
+  this->check = 0xffffffff;
+  return this->error == NULL;
+}
+
+static uint32_t Inflate_Bits(Inflate* this, int count) {
+  while (this->bitsSize < count) {
+    const int byte = Inflate_Byte(this);
+    if (byte < 0) {
+      return 0;
+    }
+    this->bits |= (uint32_t)byte << this->bitsSize;
+    this->bitsSize += 8;
+  }
+  const uint32_t value = this->bits & ((1u << count) - 1);
+  this->bits >>= count;
+  this->bitsSize -= count;
+  return value;
+}
+
+// -1 when file ended, which is an error as no stream is expected to end there
+static int Inflate_Byte(Inflate* this) {
+  const int byte = Inflate_PeekByte(this);
+  if (byte < 0) {
+    Inflate_Fail(this, "unexpected end of file");
+    return -1;
+  }
+  ++this->inputBegin;
+  return byte;
+}
+
+static int Inflate_PeekByte(Inflate* this) {
+  if (this->error) {
+    return -1;
+  }
+  if (this->inputBegin == this->inputEnd) {
+    this->inputBegin = 0;
+    this->inputEnd = fread(this->input, 1, INFLATE_INPUT_SIZE, this->file);
+    if (this->inputEnd == 0) {
+      return -1;
+    }
+  }
+  return this->input[this->inputBegin];
+}
+
+static void Inflate_Fail(Inflate* this, const char* error) {
+  if (this->error == NULL) {
+    this->error = error;
+  }
+  this->finished = true;
+}
+
+// Bytes decoded since previous update are still in window, as decoding stops at half of it
+static void Inflate_UpdateCheck(Inflate* this) {
+  const size_t from = this->checked;
+  const size_t to = this->written;
+  this->checked = this->written;
+  if (this->format == EInflateFormat_Zlib) {
+    uint32_t a = this->check & 0xffff;
+    uint32_t b = this->check >> 16;
+    for (size_t i = from; i < to; ++i) {
+      a = (a + this->window[i % INFLATE_WINDOW_SIZE]) % 65521;
+      b = (b + a) % 65521;
+    }
+    this->check = b << 16 | a;
+    return;
+  }
+  uint32_t crc = this->check;
+  for (size_t i = from; i < to; ++i) {
+    crc = this->crcTable[(crc ^ this->window[i % INFLATE_WINDOW_SIZE]) & 0xff] ^ (crc >> 8);
+  }
+  this->check = crc;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define INFLATE_INPUT_SIZE 65536
+#define INFLATE_WINDOW_SIZE 65536  // 32 KiB of history DEFLATE refers to and up to 32 KiB not read yet
+#define INFLATE_MAX_CODES 288
+
+typedef enum { EInflateFormat_None, EInflateFormat_Gzip, EInflateFormat_Zlib } EInflateFormat;
+
+// Canonical Huffman code, symbols ordered by code length
+typedef struct InflateCode {
+  uint16_t counts[16];
+  uint16_t symbols[INFLATE_MAX_CODES];
+} InflateCode;
+
+// Streaming DEFLATE decoder of gzip or zlib file. Only the window is kept in memory, input is read in blocks as lines
+// are taken out.
+typedef struct Inflate {
+  FILE* file;
+  int format;
+  uint8_t* input;
+  size_t inputBegin;
+  size_t inputEnd;
+  uint32_t bits;
+  int bitsSize;
+  uint8_t* window;
+  size_t written;     // bytes decoded in total, position in window modulo its size
+  size_t read;        // bytes taken by Inflate_Gets
+  size_t checked;     // bytes included in check
+  size_t memberSize;  // bytes decoded since beginning of gzip member
+  bool inBlock;
+  bool lastBlock;
+  bool finished;
+  int blockType;
+  size_t storedLeft;
+  size_t copyLeft;
+  size_t copyDistance;
+  InflateCode lengths;
+  InflateCode distances;
+  uint32_t crcTable[256];
+  uint32_t check;  // CRC-32 of gzip member or Adler-32 of zlib stream decoded so far
+  const char* error;
+} Inflate;
+
+EInflateFormat Inflate_Detect(FILE* file);
+Inflate Inflate_Init(FILE* file, EInflateFormat format);
+void Inflate_Destroy(Inflate* this);
+char* Inflate_Gets(Inflate* this, char* line, size_t size);
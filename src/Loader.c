@@ -0,0 +1,151 @@
+#include "Loader.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Loader {
+  pthread_t thread;
+  atomic_int state;
+  LoadProgress progress;
+  char fileName[2048];  // to display, first of sources
+  LogSource* sources;   // owned copies of file names and prefixes
+  size_t sourcesSize;
+  EVerbosity verbosity;
+  LogBook logBook;
+} Loader;
+
+static void* Loader_Run(void* arg);
+static void Loader_Join(Loader* this);
+static void Loader_FreeSources(Loader* this);
+
+size_t Loader_SizeOf() {
+  return sizeof(Loader);
+}
+
+void Loader_Init(Loader* this) {
+  atomic_init(&this->state, ELoaderState_Idle);
+  atomic_init(&this->progress.bytesParsed, 0);
+  atomic_init(&this->progress.bytesTotal, 0);
+  atomic_init(&this->progress.cancelRequested, false);
+  this->fileName[0] = '\0';
+  this->sources = NULL;
+  this->sourcesSize = 0;
+  this->verbosity = EVerbosity_Errors;
+  this->logBook = LogBook_Init();
+}
+
+void Loader_Destroy(Loader* this) {
+  Loader_Cancel(this);
+  Loader_Join(this);
+  Loader_FreeSources(this);
+  LogBook_Destroy(&this->logBook);
+}
+
+void Loader_SetVerbosity(Loader* this, EVerbosity verbosity) {
+  this->verbosity = verbosity;
+}
+
+void Loader_Start(Loader* this, const char* fileName) {
+  const LogSource source = {.fileName = fileName, .namePrefix = NULL};
+  Loader_StartMerged(this, &source, 1);
+}
+
+// Logs are merged by timestamp into one LogBook
+void Loader_StartMerged(Loader* this, const LogSource* sources, size_t sourcesSize) {
+  Loader_Cancel(this);
+  Loader_Join(this);
+
+  Loader_FreeSources(this);
+  this->sources = calloc(sourcesSize ? sourcesSize : 1, sizeof(LogSource));
+  if (this->sources == NULL) {
+    perror("Cannot calloc memory for Loader");
+    exit(10);
+  }
+  for (size_t i = 0; i < sourcesSize; ++i) {
+    this->sources[i].fileName = strdup(sources[i].fileName);
+    this->sources[i].namePrefix = sources[i].namePrefix ? strdup(sources[i].namePrefix) : NULL;
+  }
+  this->sourcesSize = sourcesSize;
+  if (sourcesSize > 1) {
+    snprintf(this->fileName, sizeof(this->fileName), "%s (+%zu)", sources[0].fileName, sourcesSize - 1);
+  } else {
+    snprintf(this->fileName, sizeof(this->fileName), "%s", sourcesSize ? sources[0].fileName : "");
+  }
+  LogBook_Destroy(&this->logBook);
+  this->logBook = LogBook_Init();
+  this->logBook.diagnostics.verbosity = this->verbosity;
+  atomic_store(&this->progress.bytesParsed, 0);
+  atomic_store(&this->progress.bytesTotal, 0);
+  atomic_store(&this->progress.cancelRequested, false);
+  atomic_store(&this->state, ELoaderState_Running);
+  if (pthread_create(&this->thread, NULL, Loader_Run, this)) {
+    perror("Cannot start loader thread");
+    exit(10);
+  }
+}
+
+void Loader_Cancel(Loader* this) {
+  atomic_store(&this->progress.cancelRequested, true);
+}
+
+bool Loader_IsRunning(const Loader* this) {
+  return atomic_load(&this->state) == ELoaderState_Running;
+}
+
+float Loader_GetProgress(const Loader* this) {
+  const size_t total = atomic_load(&this->progress.bytesTotal);
+  return total == 0 ? 0.0 : (float)atomic_load(&this->progress.bytesParsed) / total;
+}
+
+const char* Loader_GetFileName(const Loader* this) {
+  return this->fileName;
+}
+
+// Hands over loaded LogBook once the worker is done. Loader returns to idle state afterwards.
+ELoaderState Loader_Poll(Loader* this, LogBook* result) {
+  const ELoaderState state = atomic_load(&this->state);
+  if (state == ELoaderState_Idle || state == ELoaderState_Running) {
+    return state;
+  }
+  Loader_Join(this);
+  if (state == ELoaderState_Finished) {
+    *result = this->logBook;
+  } else {
+    LogBook_Destroy(&this->logBook);
+  }
+  this->logBook = LogBook_Init();
+  return state;
+}
+
+static void* Loader_Run(void* arg) {
+  Loader* this = arg;
+  if (LogBook_LoadMerged(&this->logBook, this->sources, this->sourcesSize, &this->progress)) {
+    atomic_store(&this->state, ELoaderState_Finished);
+  } else if (atomic_load(&this->progress.cancelRequested)) {
+    atomic_store(&this->state, ELoaderState_Cancelled);
+  } else {
+    atomic_store(&this->state, ELoaderState_Failed);
+  }
+  return NULL;
+}
+
+static void Loader_Join(Loader* this) {
+  if (atomic_load(&this->state) == ELoaderState_Idle) {
+    return;
+  }
+  pthread_join(this->thread, NULL);
+  atomic_store(&this->state, ELoaderState_Idle);
+}
+
+static void Loader_FreeSources(Loader* this) {
+  for (size_t i = 0; i < this->sourcesSize; ++i) {
+    free((char*)this->sources[i].fileName);
+    free((char*)this->sources[i].namePrefix);
+  }
+  free(this->sources);
+  this->sources = NULL;
+  this->sourcesSize = 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "LogBook.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct Loader Loader;
+
+typedef enum {
+  ELoaderState_Idle,
+  ELoaderState_Running,
+  ELoaderState_Finished,
+  ELoaderState_Failed,
+  ELoaderState_Cancelled
+} ELoaderState;
+
+size_t Loader_SizeOf();
+void Loader_Init(Loader* this);
+void Loader_Destroy(Loader* this);
+
+void Loader_SetVerbosity(Loader* this, EVerbosity verbosity);
+void Loader_Start(Loader* this, const char* fileName);
+void Loader_StartMerged(Loader* this, const LogSource* sources, size_t sourcesSize);
+void Loader_Cancel(Loader* this);
+bool Loader_IsRunning(const Loader* this);
+float Loader_GetProgress(const Loader* this);
+const char* Loader_GetFileName(const Loader* this);
+ELoaderState Loader_Poll(Loader* this, LogBook* result);
@@ -2,114 +2,254 @@
 
 #include "LogBook.h"
 #include "DynamicArray.h"
+#include "Inflate.h"
+#include "LogCache.h"
+#include "Profiler.h"
 #include "StringContainer.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+// Next line of one of merged logs
+typedef struct LogReader {
+  FILE* file;
+  bool compressed;
+  Inflate inflate;  // of gzip or zlib compressed file, lines are decompressed as they are read
+  const char* namePrefix;
+  char line[128];
+  size_t lineNumber;
+  size_t bytes;               // of uncompressed file read so far
+  time_t timestamp;           // of line, or of last line with valid one
+  LogCachePosition complete;  // after last line ending with newline, what parse cache can hold
+} LogReader;
+
 static LogEntry LogBook_MakeEntryFromString(LogBook* this, const char* line, const size_t lineNumber);
 static void LogBook_MakeDependencies(LogBook* this, LogEntry* le, char* fieldBegin, char* fieldEnd);
+static char* LogBook_DependenciesEnd(char* dependencies);
+static bool LogBook_ParseTimestamp(const char* text, time_t* timestamp);
 static size_t LogBook_FindNodeNameOffset(LogBook* this, const char* name);
+static size_t LogBook_InternNodeName(LogBook* this, const char* name);
+static const char* LogBook_PrefixNodeName(const LogBook* this, const char* name, char* buffer, size_t bufferSize);
+static size_t* LogBook_NameSlot(const LogBook* this, const char* name);
+static void LogBook_GrowNameTable(LogBook* this);
+static void LogBook_IndexNodeNames(LogBook* this);
+static void LogBook_MarkComplete(const LogBook* this, LogReader* reader);
+static bool LogBook_ReadLine(LogReader* reader, bool merging);
+static bool LogBook_ReaderBefore(const LogReader* readers, size_t left, size_t right);
+static void LogBook_SiftUp(const LogReader* readers, size_t* heap, size_t i);
+static void LogBook_SiftDown(const LogReader* readers, size_t* heap, size_t heapSize);
+static size_t LogBook_BytesRead(const LogReader* readers, size_t readersSize);
+static void LogBook_BuildLatestTimes(LogBook* this);
 
 LogBook LogBook_Init() {
   LogBook this = (LogBook){
       .entries = NULL,
       .entriesSize = 0,
+      .latestTimes = NULL,
       .nodeNames = StringContainer_Init(),
+      .nameTable = NULL,
+      .nameTableCapacity = 0,
+      .namePrefix = NULL,
+      .nameIndex = NodeIndex_Init(),
+      .stats = NodeStats_Init(),
+      .activity = ActivityMap_Init(),
+      .diagnostics = Diagnostics_Init(EVerbosity_Errors),
   };
   return this;
 }
 
-void LogBook_Load(LogBook* this, const char* fileName) {
+bool LogBook_Load(LogBook* this, const char* fileName, LoadProgress* progress) {
   if (!fileName) {
     perror("filename is NULL");
-    exit(10);
+    return false;
   }
+  const LogSource source = {.fileName = fileName, .namePrefix = NULL};
+  return LogBook_LoadMerged(this, &source, 1, progress);
+}
+
+// Streaming k-way merge, every log is read once and in order. Line of earliest timestamp among next lines of all logs
+// is parsed next, ties go to the log given first. Entries of one log keep their order even if it is not sorted.
+// Single log is taken from its parse cache when it did not change, or only its appended lines are parsed.
+bool LogBook_LoadMerged(LogBook* this, const LogSource* sources, size_t sourcesSize, LoadProgress* progress) {
+  PROFILER_SCOPE(EPhase_Load);
+  const size_t PROGRESS_STEP = 1024;  // lines parsed between progress updates
 
-  FILE* fptr = fopen(fileName, "r");
-  if (fptr == NULL) {
-    perror("Cannot read file: ");
-    perror(fileName);
-    exit(1);
+  LogReader* readers = calloc(sourcesSize ? sourcesSize : 1, sizeof(LogReader));
+  size_t* heap = calloc(sourcesSize ? sourcesSize : 1, sizeof(size_t));  // indexes of readers with line to parse
+  if (readers == NULL || heap == NULL) {
+    perror("Cannot calloc memory for LogBook readers");
+    exit(10);
   }
-  char buffer[128];
-  memset(buffer, '\0', 128);
-  while (fgets(buffer, sizeof(buffer), fptr)) {
-    ++this->entriesSize;
+  bool readable = sourcesSize > 0;
+  size_t bytesTotal = 0;
+  for (size_t i = 0; readable && i < sourcesSize; ++i) {
+    readers[i].namePrefix = sources[i].namePrefix;
+    readers[i].file = fopen(sources[i].fileName, "r");
+    if (readers[i].file == NULL) {
+      perror("Cannot read file: ");
+      perror(sources[i].fileName);
+      readable = false;
+      break;
+    }
+    fseek(readers[i].file, 0, SEEK_END);
+    bytesTotal += ftell(readers[i].file);
+    rewind(readers[i].file);
+    const EInflateFormat format = Inflate_Detect(readers[i].file);
+    readers[i].compressed = format != EInflateFormat_None;
+    if (readers[i].compressed) {
+      readers[i].inflate = Inflate_Init(readers[i].file, format);
+    }
+  }
+  if (progress) {
+    atomic_store(&progress->bytesTotal, bytesTotal);
   }
-  fclose(fptr);
 
-  fptr = fopen(fileName, "r");
-  if (fptr == NULL) {
-    perror("Cannot read file: ");
-    perror(fileName);
-    exit(1);
+  const bool caching = readable && sourcesSize == 1 && sources[0].namePrefix == NULL;
+  const bool cached = caching && LogCache_Read(this, sources[0].fileName, readers[0].compressed, &readers[0].complete);
+  if (cached) {
+    LogBook_IndexNodeNames(this);
+    readers[0].lineNumber = readers[0].complete.lineNumber;
+    readers[0].bytes = readers[0].complete.bytes;
+    if (!readers[0].compressed) {
+      fseek(readers[0].file, readers[0].bytes, SEEK_SET);
+    }
   }
+  const size_t cachedEntries = this->entriesSize;
 
-  this->entries = calloc(sizeof(LogEntry), this->entriesSize);
-  if (this->entries == NULL) {
-    perror("Cannot calloc memory for LogBook entries");
-    exit(10);
+  size_t heapSize = 0;
+  for (size_t i = 0; readable && i < sourcesSize; ++i) {
+    if (cached && readers[i].compressed) {
+      continue;  // compressed log is cached only when it did not change at all
+    }
+    if (LogBook_ReadLine(&readers[i], sourcesSize > 1)) {
+      heap[heapSize] = i;
+      LogBook_SiftUp(readers, heap, heapSize++);
+    }
   }
 
-  StringContainer_Append(&this->nodeNames, "<UnknownNode>");
-  size_t i = 0;
-  while (fgets(buffer, sizeof(buffer), fptr)) {
-    this->entries[i] = LogBook_MakeEntryFromString(this, buffer, i + 1);
-    ++i;
+  size_t entriesCapacity = this->entriesSize;
+  bool cancelled = false;
+  if (!cached) {
+    StringContainer_Append(&this->nodeNames, "<UnknownNode>");
+  }
+  while (readable && !cancelled && heapSize > 0) {
+    LogReader* reader = &readers[heap[0]];
+    if (this->entriesSize == entriesCapacity) {
+      entriesCapacity = entriesCapacity == 0 ? PROGRESS_STEP : entriesCapacity * 2;
+      this->entries = realloc(this->entries, entriesCapacity * sizeof(LogEntry));
+      if (this->entries == NULL) {
+        perror("Cannot realloc memory for LogBook entries");
+        exit(10);
+      }
+    }
+    this->namePrefix = reader->namePrefix;
+    this->entries[this->entriesSize] = LogBook_MakeEntryFromString(this, reader->line, reader->lineNumber);
+    ++this->entriesSize;
+    if (caching) {
+      LogBook_MarkComplete(this, reader);
+    }
+    if (!LogBook_ReadLine(reader, sourcesSize > 1)) {
+      heap[0] = heap[--heapSize];
+    }
+    LogBook_SiftDown(readers, heap, heapSize);
+
+    if (progress && this->entriesSize % PROGRESS_STEP == 0) {
+      atomic_store(&progress->bytesParsed, LogBook_BytesRead(readers, sourcesSize));
+      cancelled = atomic_load(&progress->cancelRequested);
+    }
+  }
+  this->namePrefix = NULL;
+  if (readable && this->diagnostics.verbosity >= EVerbosity_Verbose) {
+    StringContainer_Print(&this->nodeNames);
+  }
+  if (progress) {
+    atomic_store(&progress->bytesParsed, LogBook_BytesRead(readers, sourcesSize));
+  }
+  const LogCachePosition* complete = &readers[0].complete;
+  bool cacheable = caching && !cancelled && complete->entriesSize > cachedEntries;
+  if (cacheable && readers[0].compressed) {
+    cacheable = !readers[0].inflate.error && complete->entriesSize == this->entriesSize;
+  }
+  if (cacheable) {
+    LogCache_Write(this, sources[0].fileName, readers[0].compressed, complete);
   }
-  StringContainer_Print(&this->nodeNames);
-  fclose(fptr);
+  for (size_t i = 0; i < sourcesSize; ++i) {
+    if (readers[i].compressed) {
+      if (readers[i].inflate.error && !cancelled) {
+        fprintf(stderr, "Cannot decompress %s: %s\n", sources[i].fileName, readers[i].inflate.error);
+        readable = false;
+      }
+      Inflate_Destroy(&readers[i].inflate);
+    }
+    if (readers[i].file) {
+      fclose(readers[i].file);
+    }
+  }
+  free(heap);
+  free(readers);
+  if (!readable) {
+    return false;
+  }
+  if (!cancelled) {
+    LogBook_BuildLatestTimes(this);
+    NodeIndex_Build(&this->nameIndex, &this->nodeNames);
+    NodeStats_Build(&this->stats, this);
+    ActivityMap_Build(&this->activity, this);
+  }
+  return !cancelled;
 }
 
 void LogBook_Destroy(LogBook* this) {
+  NodeIndex_Destroy(&this->nameIndex);
+  NodeStats_Destroy(&this->stats);
+  ActivityMap_Destroy(&this->activity);
   StringContainer_Destroy(&this->nodeNames);
+  free(this->nameTable);
+  this->nameTable = NULL;
+  this->nameTableCapacity = 0;
+  Diagnostics_Destroy(&this->diagnostics);
   if (this->entries) {
     free(this->entries);
   }
+  this->entries = NULL;
   this->entriesSize = 0;
+  free(this->latestTimes);
+  this->latestTimes = NULL;
 }
 
 unsigned int LogBook_IsLoaded(LogBook* this) {
     return this->entries != NULL;
 }
 
-LogEntry LogBook_SyntaxWrongTimestamp(LogEntry* le, const char* timestamp, const size_t lineNumber) {
+LogEntry LogBook_SyntaxWrongTimestamp(LogBook* this, LogEntry* le, const char* timestamp, const size_t lineNumber) {
   le->timestamp = 0;
-  char reason[512];
-  snprintf(reason, 511, "Wrong timestamp '%s' at line %ld. Should be in '%%Y-%%m-%%dT%%H:%%M:%%S%%z' format.",
-           timestamp, lineNumber);
-  printf("%s\n", reason);
+  Diagnostics_Report(&this->diagnostics, EDiagnostic_WrongTimestamp, lineNumber,
+                     "Wrong timestamp '%s'. Should be in '%%Y-%%m-%%dT%%H:%%M:%%S%%z' format.", timestamp);
   return *le;
 }
 
-LogEntry LogBook_SyntaxWrongOperation(LogEntry* le, const char* operation, const size_t lineNumber) {
+LogEntry LogBook_SyntaxWrongOperation(LogBook* this, LogEntry* le, const char* operation, const size_t lineNumber) {
   le->operation = EOperation_None;
-  char reason[512];
-  snprintf(reason, 511, "Wrong operation '%s' at line %ld", operation, lineNumber);
-  printf("%s\n", reason);
+  Diagnostics_Report(&this->diagnostics, EDiagnostic_WrongOperation, lineNumber, "Wrong operation '%s'", operation);
   return *le;
 }
 
-LogEntry LogBook_SyntaxUnknownNodeName(LogEntry* le, const char* nodeName, const size_t lineNumber) {
-  char reason[512];
-  snprintf(reason, 511, "Unknown nodeName '%s' at line %ld", nodeName, lineNumber);
-  printf("%s\n", reason);
+LogEntry LogBook_SyntaxUnknownNodeName(LogBook* this, LogEntry* le, const char* nodeName, const size_t lineNumber) {
+  Diagnostics_Report(&this->diagnostics, EDiagnostic_UnknownNodeName, lineNumber, "Unknown nodeName '%s'", nodeName);
   return *le;
 }
 
-LogEntry LogBook_SyntaxWrongStatus(LogEntry* le, const char* status, const size_t lineNumber) {
+LogEntry LogBook_SyntaxWrongStatus(LogBook* this, LogEntry* le, const char* status, const size_t lineNumber) {
   le->status = EStatus_Waiting;
-  char reason[512];
-  snprintf(reason, 511, "Wrong status '%s' at line %ld", status, lineNumber);
-  printf("%s\n", reason);
+  Diagnostics_Report(&this->diagnostics, EDiagnostic_WrongStatus, lineNumber, "Wrong status '%s'", status);
   return *le;
 }
 
 LogEntry LogBook_MakeEntryFromString(LogBook* this, const char* buffer, const size_t lineNumber) {
-  char timestamp[20];
+  char timestamp[32];
   char operation[3];
   char nodeName[128];
   char operSpecific[512];
@@ -118,7 +258,7 @@ LogEntry LogBook_MakeEntryFromString(LogBook* this, const char* buffer, const si
   memset(operation, '\0', sizeof(operation));
   memset(timestamp, '\0', sizeof(timestamp));
   memset(operSpecific, '\0', sizeof(operSpecific));
-  sscanf(buffer, "%s %s %s%[][0-9a-zA-Z, \n]", timestamp, operation, nodeName, operSpecific);
+  sscanf(buffer, "%31s %2s %127s%511[][0-9a-zA-Z, \n]", timestamp, operation, nodeName, operSpecific);
   LogEntry le = {
       .operation = EOperation_None,
       .status = EStatus_Finished,
@@ -127,85 +267,85 @@ LogEntry LogBook_MakeEntryFromString(LogBook* this, const char* buffer, const si
   };
   memset(le.dependencies, '\0', sizeof(le.dependencies));
 
-  struct tm tm;
-  memset(&tm, '\0', sizeof(struct tm));
-  char* isOk = strptime(timestamp, "%Y-%m-%dT%H:%M:%S%z", &tm);
-  if (!isOk) {
-    return LogBook_SyntaxWrongTimestamp(&le, timestamp, lineNumber);
+  if (!LogBook_ParseTimestamp(timestamp, &le.timestamp)) {
+    return LogBook_SyntaxWrongTimestamp(this, &le, timestamp, lineNumber);
   }
-  le.timestamp = mktime(&tm);
 
   switch (operation[0]) {  // clang-format off
     case 's': le.operation = EOperation_StatusChange; break;
     case '+': switch (operation[1]) {
         case '\0': le.operation = EOperation_Add; break;
         case 'd': le.operation = EOperation_AddDependency; break;
-        default: return LogBook_SyntaxWrongOperation(&le, operation, lineNumber);
+        default: return LogBook_SyntaxWrongOperation(this, &le, operation, lineNumber);
       } break;
     case '-': switch (operation[1]) {
         case '\0': le.operation = EOperation_Remove; break;
 		case 'd': le.operation = EOperation_RemoveDependency; break;
-        default: return LogBook_SyntaxWrongOperation(&le, operation, lineNumber);
+        default: return LogBook_SyntaxWrongOperation(this, &le, operation, lineNumber);
       } break;
-    default: return LogBook_SyntaxWrongOperation(&le, operation, lineNumber);
+    default: return LogBook_SyntaxWrongOperation(this, &le, operation, lineNumber);
   }  // clang-format on
 
   switch (le.operation) {
     case EOperation_Add: {
-      le.nodeName = StringContainer_Append(&this->nodeNames, nodeName);
+      le.nodeName = LogBook_InternNodeName(this, nodeName);
+      Diagnostics_Trace(&this->diagnostics, "Added %s name\n", nodeName);
       char status[10];
-      char dependencies[512];
-      sscanf(operSpecific, " %s %[][0-9a-zA-Z, \n]", status, dependencies);
+      char dependencies[512] = "";
+      sscanf(operSpecific, " %9s %511[][0-9a-zA-Z, \n]", status, dependencies);
 
       switch (status[0]) {  // clang-format off
         case 'o': le.status = EStatus_Ongoing; break;
         case 'w': le.status = EStatus_Waiting; break;
         case 'f': le.status = EStatus_Finished; break;
-        default: return LogBook_SyntaxWrongStatus(&le, status, lineNumber);
+        default: return LogBook_SyntaxWrongStatus(this, &le, status, lineNumber);
       }  // clang-format on
 
-      char* dependenciesEnd = strchr(dependencies, ']');
-      printf("dependencies of %s: %s", LogBook_GetNodeName(this, le.nodeName), dependencies);
+      char* dependenciesEnd = LogBook_DependenciesEnd(dependencies);
+      Diagnostics_Trace(&this->diagnostics, "dependencies of %s: %s", LogBook_GetNodeName(this, le.nodeName),
+                        dependencies);
       LogBook_MakeDependencies(this, &le, dependencies + 1, dependenciesEnd - 1);
       return le;
     }
     case EOperation_StatusChange: {
       le.nodeName = LogBook_FindNodeNameOffset(this, nodeName);
       if (!le.nodeName) {
-        return LogBook_SyntaxUnknownNodeName(&le, nodeName, lineNumber);
+        return LogBook_SyntaxUnknownNodeName(this, &le, nodeName, lineNumber);
       }
 
       char status[10];
-      sscanf(operSpecific, " %s", status);
+      sscanf(operSpecific, " %9s", status);
 
       switch (status[0]) {  // clang-format off
         case 'o': le.status = EStatus_Ongoing; break;
         case 'w': le.status = EStatus_Waiting; break;
-        default: return LogBook_SyntaxWrongStatus(&le, status, lineNumber);
+        default: return LogBook_SyntaxWrongStatus(this, &le, status, lineNumber);
       }  // clang-format on
 
-      printf("new status of %s: %d\n", LogBook_GetNodeName(this, le.nodeName), le.status);
+      Diagnostics_Trace(&this->diagnostics, "new status of %s: %d\n", LogBook_GetNodeName(this, le.nodeName),
+                        le.status);
       return le;
     }
     case EOperation_Remove: {
       le.nodeName = LogBook_FindNodeNameOffset(this, nodeName);
       if (!le.nodeName) {
-        return LogBook_SyntaxUnknownNodeName(&le, nodeName, lineNumber);
+        return LogBook_SyntaxUnknownNodeName(this, &le, nodeName, lineNumber);
       }
       le.status = EStatus_Finished;
-      printf("removal of %s\n", nodeName);
+      Diagnostics_Trace(&this->diagnostics, "removal of %s\n", nodeName);
       return le;
     }
     case EOperation_AddDependency:
     case EOperation_RemoveDependency: {
       le.nodeName = LogBook_FindNodeNameOffset(this, nodeName);
       if (!le.nodeName) {
-        return LogBook_SyntaxUnknownNodeName(&le, nodeName, lineNumber);
+        return LogBook_SyntaxUnknownNodeName(this, &le, nodeName, lineNumber);
       }
-      char dependencies[512];
-      sscanf(operSpecific, " %[][0-9a-zA-Z, \n]", dependencies);
-      char* dependenciesEnd = strchr(dependencies, ']');
-      printf("dependencies of %s: %s\n", LogBook_GetNodeName(this, le.nodeName), dependencies);
+      char dependencies[512] = "";
+      sscanf(operSpecific, " %511[][0-9a-zA-Z, \n]", dependencies);
+      char* dependenciesEnd = LogBook_DependenciesEnd(dependencies);
+      Diagnostics_Trace(&this->diagnostics, "dependencies of %s: %s\n", LogBook_GetNodeName(this, le.nodeName),
+                        dependencies);
       LogBook_MakeDependencies(this, &le, dependencies + 1, dependenciesEnd - 1);
       return le;
     }
@@ -225,7 +365,7 @@ void LogBook_MakeDependencies(LogBook* this, LogEntry* logEntry, char* begin, ch
       nameEnd = end;
     }
 
-    fprintf(stdout, "dependencies[%ld]: %s\n", nextDependency, nameBegin);
+    Diagnostics_Trace(&this->diagnostics, "dependencies[%ld]: %s\n", nextDependency, nameBegin);
     logEntry->dependencies[nextDependency++] = LogBook_FindNodeNameOffset(this, nameBegin);
     if (nameEnd + 1 < end) {
       nameBegin = strchr(nameEnd + 1, ' ');
@@ -244,6 +384,34 @@ char* LogBook_GetNodeName(const LogBook* this, const size_t offset) {
   return &this->nodeNames.begin[offset];
 }
 
+// Last entry with it and every entry before it not later than timestamp, (size_t)-1 when first entry is later.
+// Entries need not be in time order, lines with wrong timestamp have 0 and merged logs keep their own order.
+size_t LogBook_FindEntry(const LogBook* this, time_t timestamp) {
+  if (this->latestTimes == NULL) {
+    return (size_t)-1;
+  }
+  size_t low = 0;
+  size_t high = this->entriesSize;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (this->latestTimes[middle] <= timestamp) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low - 1;
+}
+
+const char* LogBook_StatusName(EStatus status) {
+  switch (status) {  // clang-format off
+    case EStatus_Waiting: return "waiting";
+    case EStatus_Ongoing: return "ongoing";
+    case EStatus_Finished: return "finished";
+    default: return "unknown";
+  }  // clang-format on
+}
+
 void LogBook_Print(LogBook* this) {
   for (const LogEntry* le = this->entries; le < this->entries + this->entriesSize; ++le) {
     char deps[1024];
@@ -256,14 +424,186 @@ void LogBook_Print(LogBook* this) {
   }
 }
 
+// Closing bracket, or end of line cut short, e.g. by damaged compressed file
+static char* LogBook_DependenciesEnd(char* dependencies) {
+  char* end = strchr(dependencies, ']');
+  return end ? end : dependencies + strlen(dependencies);
+}
+
+static bool LogBook_ParseTimestamp(const char* text, time_t* timestamp) {
+  struct tm tm;
+  memset(&tm, '\0', sizeof(struct tm));
+  if (!strptime(text, "%Y-%m-%dT%H:%M:%S%z", &tm)) {
+    return false;
+  }
+  *timestamp = mktime(&tm);
+  return true;
+}
+
 static size_t LogBook_FindNodeNameOffset(LogBook* this, const char* name) {
-  size_t array_size =
-      DynamicArray_End(size_t, this->nodeNames.offsets) - DynamicArray_Begin(size_t, this->nodeNames.offsets);
-  for (size_t i = 1; i < array_size; ++i) {
-    const char* current = StringContainer_At(&this->nodeNames, i);
-    if (0 == strcmp(current, name)) {
-      return current - this->nodeNames.begin;
+  char buffer[256];
+  const size_t* slot = LogBook_NameSlot(this, LogBook_PrefixNodeName(this, name, buffer, sizeof(buffer)));
+  return slot ? *slot : 0;
+}
+
+// Name added again keeps pointing to its first offset, as lookups did before
+static size_t LogBook_InternNodeName(LogBook* this, const char* name) {
+  char buffer[256];
+  const char* prefixed = LogBook_PrefixNodeName(this, name, buffer, sizeof(buffer));
+  const size_t count = DynamicArray_Size(size_t, this->nodeNames.offsets);
+  if (2 * count >= this->nameTableCapacity) {
+    LogBook_GrowNameTable(this);
+  }
+  size_t* slot = LogBook_NameSlot(this, prefixed);
+  const size_t offset = StringContainer_Append(&this->nodeNames, (char*)prefixed);
+  if (*slot == 0) {
+    *slot = offset;
+  }
+  return offset;
+}
+
+static const char* LogBook_PrefixNodeName(const LogBook* this, const char* name, char* buffer, size_t bufferSize) {
+  if (this->namePrefix == NULL) {
+    return name;
+  }
+  snprintf(buffer, bufferSize, "%s%s", this->namePrefix, name);
+  return buffer;
+}
+
+// Slot holding offset of given name, or free slot it would take. NULL while table is empty.
+static size_t* LogBook_NameSlot(const LogBook* this, const char* name) {
+  if (this->nameTableCapacity == 0) {
+    return NULL;
+  }
+  uint64_t hash = 14695981039346656037ull;  // FNV-1a
+  for (const char* c = name; *c; ++c) {
+    hash = (hash ^ (unsigned char)*c) * 1099511628211ull;
+  }
+  const size_t mask = this->nameTableCapacity - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    size_t* slot = &this->nameTable[i];
+    if (*slot == 0 || 0 == strcmp(this->nodeNames.begin + *slot, name)) {
+      return slot;
+    }
+  }
+}
+
+static void LogBook_GrowNameTable(LogBook* this) {
+  size_t* old = this->nameTable;
+  const size_t oldCapacity = this->nameTableCapacity;
+  this->nameTableCapacity = oldCapacity ? oldCapacity * 2 : 1024;
+  this->nameTable = calloc(this->nameTableCapacity, sizeof(size_t));
+  if (this->nameTable == NULL) {
+    perror("Cannot calloc memory for LogBook names");
+    exit(10);
+  }
+  for (size_t i = 0; i < oldCapacity; ++i) {
+    if (old[i] != 0) {
+      *LogBook_NameSlot(this, this->nodeNames.begin + old[i]) = old[i];
+    }
+  }
+  free(old);
+}
+
+// Offsets restored from parse cache, first offset of every name is indexed as when names were interned
+static void LogBook_IndexNodeNames(LogBook* this) {
+  const size_t* offsets = DynamicArray_Begin(size_t, this->nodeNames.offsets);
+  const size_t count = DynamicArray_Size(size_t, this->nodeNames.offsets);
+  for (size_t i = 1; i < count; ++i) {  // <UnknownNode> is not looked up
+    if (2 * i >= this->nameTableCapacity) {
+      LogBook_GrowNameTable(this);
+    }
+    size_t* slot = LogBook_NameSlot(this, this->nodeNames.begin + offsets[i]);
+    if (*slot == 0) {
+      *slot = offsets[i];
+    }
+  }
+}
+
+// Line without newline is either last one of growing log or cut into pieces, it is parsed again on reopen
+static void LogBook_MarkComplete(const LogBook* this, LogReader* reader) {
+  if (strchr(reader->line, '\n') == NULL) {
+    return;
+  }
+  reader->complete = (LogCachePosition){
+      .bytes = reader->bytes,
+      .lineNumber = reader->lineNumber,
+      .entriesSize = this->entriesSize,
+      .namesBytes = this->nodeNames.end - this->nodeNames.begin,
+      .diagnosticsSize = Diagnostics_RecordsSize(&this->diagnostics),
+  };
+  memcpy(reader->complete.diagnosticsCounts, this->diagnostics.counts, sizeof(this->diagnostics.counts));
+}
+
+// Timestamp is parsed ahead only when logs are merged, lines with wrong one keep their place after previous line
+static bool LogBook_ReadLine(LogReader* reader, bool merging) {
+  const char* line = reader->compressed ? Inflate_Gets(&reader->inflate, reader->line, sizeof(reader->line))
+                                        : fgets(reader->line, sizeof(reader->line), reader->file);
+  if (!line) {
+    return false;
+  }
+  ++reader->lineNumber;
+  reader->bytes += reader->compressed ? 0 : strlen(reader->line);
+  char timestamp[32];
+  if (merging && sscanf(reader->line, "%31s", timestamp) == 1) {
+    LogBook_ParseTimestamp(timestamp, &reader->timestamp);
+  }
+  return true;
+}
+
+static bool LogBook_ReaderBefore(const LogReader* readers, size_t left, size_t right) {
+  if (readers[left].timestamp != readers[right].timestamp) {
+    return readers[left].timestamp < readers[right].timestamp;
+  }
+  return left < right;
+}
+
+static void LogBook_SiftUp(const LogReader* readers, size_t* heap, size_t i) {
+  while (i > 0 && LogBook_ReaderBefore(readers, heap[i], heap[(i - 1) / 2])) {
+    const size_t parent = heap[(i - 1) / 2];
+    heap[(i - 1) / 2] = heap[i];
+    heap[i] = parent;
+    i = (i - 1) / 2;
+  }
+}
+
+static void LogBook_SiftDown(const LogReader* readers, size_t* heap, size_t heapSize) {
+  size_t i = 0;
+  while (true) {
+    size_t first = i;
+    for (size_t child = 2 * i + 1; child <= 2 * i + 2 && child < heapSize; ++child) {
+      if (LogBook_ReaderBefore(readers, heap[child], heap[first])) {
+        first = child;
+      }
     }
+    if (first == i) {
+      return;
+    }
+    const size_t swapped = heap[first];
+    heap[first] = heap[i];
+    heap[i] = swapped;
+    i = first;
+  }
+}
+
+static void LogBook_BuildLatestTimes(LogBook* this) {
+  free(this->latestTimes);
+  this->latestTimes = malloc((this->entriesSize ? this->entriesSize : 1) * sizeof(time_t));
+  if (this->latestTimes == NULL) {
+    perror("Cannot malloc memory for LogBook times");
+    exit(10);
+  }
+  time_t latest = this->entriesSize ? this->entries[0].timestamp : 0;
+  for (size_t i = 0; i < this->entriesSize; ++i) {
+    latest = this->entries[i].timestamp > latest ? this->entries[i].timestamp : latest;
+    this->latestTimes[i] = latest;
+  }
+}
+
+static size_t LogBook_BytesRead(const LogReader* readers, size_t readersSize) {
+  size_t bytes = 0;
+  for (size_t i = 0; i < readersSize; ++i) {
+    bytes += readers[i].file ? (size_t)ftell(readers[i].file) : 0;
   }
-  return 0;
+  return bytes;
 }
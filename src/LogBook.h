@@ -1,6 +1,13 @@
 #pragma once
 
+#include "ActivityMap.h"
+#include "Diagnostics.h"
+#include "NodeIndex.h"
+#include "NodeStats.h"
 #include "StringContainer.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <time.h>
 
 typedef enum {
@@ -12,7 +19,7 @@ typedef enum {
   EOperation_None
 } EOperation;
 
-typedef enum { EStatus_Waiting, EStatus_Ongoing, EStatus_Finished } EStatus;
+typedef enum { EStatus_Waiting, EStatus_Ongoing, EStatus_Finished, EStatus_Size } EStatus;
 
 typedef struct LogEntry{
   EOperation operation;
@@ -25,13 +32,36 @@ typedef struct LogEntry{
 typedef struct LogBook{
 	LogEntry* entries;
 	size_t entriesSize;
+	time_t* latestTimes;  // running maximum of entry timestamps, sorted even when entries are not
 	StringContainer nodeNames;
+	size_t* nameTable;  // offsets of nodeNames by hash, 0 marks free slot
+	size_t nameTableCapacity;
+	const char* namePrefix;  // of source being parsed
+	NodeIndex nameIndex;
+	NodeStats stats;
+	ActivityMap activity;
+	Diagnostics diagnostics;
 } LogBook;
 
+// One of logs merged by timestamp into single LogBook
+typedef struct LogSource {
+  const char* fileName;
+  const char* namePrefix;  // prepended to every node name of this log, NULL for none
+} LogSource;
+
+typedef struct LoadProgress {
+  atomic_size_t bytesParsed;
+  atomic_size_t bytesTotal;
+  atomic_bool cancelRequested;
+} LoadProgress;
+
 LogBook LogBook_Init();
 void LogBook_Destroy(LogBook* this);
-void LogBook_Load(LogBook* this, const char* fileName);
+bool LogBook_Load(LogBook* this, const char* fileName, LoadProgress* progress);
+bool LogBook_LoadMerged(LogBook* this, const LogSource* sources, size_t sourcesSize, LoadProgress* progress);
 unsigned int LogBook_IsLoaded(LogBook* this);
 void LogBook_Print(LogBook* this);
 char* LogBook_GetNodeName(const LogBook *this, const size_t offset);
+const char* LogBook_StatusName(EStatus status);
+size_t LogBook_FindEntry(const LogBook* this, time_t timestamp);
 
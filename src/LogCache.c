@@ -0,0 +1,341 @@
+#include "LogCache.h"
+#include "Diagnostics.h"
+#include "LogBook.h"
+#include "StringContainer.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LOG_CACHE_VERSION 1
+#define LOG_CACHE_HASHED_BYTES 4096  // at beginning of log and right before parsed position
+
+typedef struct LogCacheHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t recordSize;  // of Diagnostic, layout of records written as they are in memory
+  uint64_t compressed;
+  uint64_t fileSize;
+  int64_t mtimeSeconds;
+  int64_t mtimeNanoseconds;
+  uint64_t headHash;
+  uint64_t tailHash;
+  uint64_t bytes;
+  uint64_t lineNumber;
+  uint64_t entriesSize;
+  uint64_t dependenciesSize;  // of all entries together
+  uint64_t namesBytes;
+  uint64_t diagnosticsSize;
+  uint64_t diagnosticsCounts[EDiagnostic_KindsSize];
+  uint64_t bodyHash;  // of everything after header, damaged cache is parsed again
+} LogCacheHeader;
+
+// LogEntry without its unused dependency slots, followed by dependenciesSize offsets
+typedef struct LogCacheEntry {
+  int64_t timestamp;
+  uint64_t nodeName;
+  uint8_t operation;
+  uint8_t status;
+  uint8_t dependenciesSize;
+  uint8_t padding[5];
+} LogCacheEntry;
+
+static bool LogCache_Path(const char* fileName, bool sidecar, char* path, size_t pathSize);
+static FILE* LogCache_Create(const char* fileName, char* path, size_t pathSize, char* temporary, size_t temporarySize);
+static uint64_t LogCache_Hash(int fd, size_t begin, size_t size);
+static uint64_t LogCache_HashString(uint64_t hash, const char* text);
+static uint64_t LogCache_HashBytes(uint64_t hash, const void* data, size_t size);
+static void LogCache_Put(FILE* file, const void* data, size_t size, uint64_t* hash);
+static bool LogCache_Matches(const LogCacheHeader* header, const char* fileName, bool compressed);
+static bool LogCache_Restore(LogBook* logBook, const LogCacheHeader* header, const uint8_t* body, size_t bodySize);
+static size_t LogCache_Padded(size_t size);
+static void LogCache_Pad(FILE* file, size_t size, uint64_t* hash);
+
+// Entries, names and diagnostics of fileName parsed before. Log which only grew since then is parsed from position on.
+bool LogCache_Read(LogBook* logBook, const char* fileName, bool compressed, LogCachePosition* position) {
+  for (int sidecar = 1; sidecar >= 0; --sidecar) {
+    char path[PATH_MAX];
+    if (!LogCache_Path(fileName, sidecar, path, sizeof(path))) {
+      continue;
+    }
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+      continue;
+    }
+    struct stat status;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && (size_t)status.st_size >= sizeof(LogCacheHeader)) {
+      mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapped == MAP_FAILED) {
+      continue;
+    }
+    const LogCacheHeader* header = mapped;
+    const bool hit = LogCache_Matches(header, fileName, compressed) &&
+                     LogCache_Restore(logBook, header, (const uint8_t*)mapped + sizeof(LogCacheHeader),
+                                      status.st_size - sizeof(LogCacheHeader));
+    if (hit) {
+      *position = (LogCachePosition){
+          .bytes = header->bytes,
+          .lineNumber = header->lineNumber,
+          .entriesSize = header->entriesSize,
+          .namesBytes = header->namesBytes,
+          .diagnosticsSize = header->diagnosticsSize,
+      };
+      for (size_t i = 0; i < EDiagnostic_KindsSize; ++i) {
+        position->diagnosticsCounts[i] = header->diagnosticsCounts[i];
+      }
+    }
+    munmap(mapped, status.st_size);
+    if (hit) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Written next to log, or to user cache directory when that is not writable. Failure only costs next load a full parse.
+void LogCache_Write(const LogBook* logBook, const char* fileName, bool compressed, const LogCachePosition* position) {
+  const int fd = open(fileName, O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    close(fd);
+    return;
+  }
+  const size_t bytes = compressed ? (size_t)status.st_size : position->bytes;
+  const size_t hashed = bytes < LOG_CACHE_HASHED_BYTES ? bytes : LOG_CACHE_HASHED_BYTES;
+  LogCacheHeader header = {
+      .magic = "DVCACHE",
+      .version = LOG_CACHE_VERSION,
+      .recordSize = sizeof(Diagnostic),
+      .compressed = compressed,
+      .fileSize = status.st_size,
+      .mtimeSeconds = status.st_mtim.tv_sec,
+      .mtimeNanoseconds = status.st_mtim.tv_nsec,
+      .headHash = LogCache_Hash(fd, 0, hashed),
+      .tailHash = LogCache_Hash(fd, bytes - hashed, hashed),
+      .bytes = bytes,
+      .lineNumber = position->lineNumber,
+      .entriesSize = position->entriesSize,
+      .dependenciesSize = 0,
+      .namesBytes = position->namesBytes,
+      .diagnosticsSize = position->diagnosticsSize,
+      .bodyHash = 14695981039346656037ull,
+  };
+  close(fd);
+  for (size_t i = 0; i < EDiagnostic_KindsSize; ++i) {
+    header.diagnosticsCounts[i] = position->diagnosticsCounts[i];
+  }
+  uint8_t* dependenciesSizes = malloc(header.entriesSize ? header.entriesSize : 1);
+  if (dependenciesSizes == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < header.entriesSize; ++i) {
+    const LogEntry* le = &logBook->entries[i];
+    size_t size = sizeof(le->dependencies) / sizeof(le->dependencies[0]);
+    while (size > 0 && le->dependencies[size - 1] == 0) {  // unknown dependency in the middle keeps its 0
+      --size;
+    }
+    dependenciesSizes[i] = size;
+    header.dependenciesSize += size;
+  }
+
+  char path[PATH_MAX];
+  char temporary[PATH_MAX + 8];
+  FILE* file = LogCache_Create(fileName, path, sizeof(path), temporary, sizeof(temporary));
+  if (file == NULL) {
+    free(dependenciesSizes);
+    return;
+  }
+  fwrite(&header, sizeof(header), 1, file);  // written again once body hash is known
+  LogCache_Put(file, logBook->nodeNames.begin, header.namesBytes, &header.bodyHash);
+  LogCache_Pad(file, header.namesBytes, &header.bodyHash);
+  for (size_t i = 0; i < header.diagnosticsSize; ++i) {
+    LogCache_Put(file, Diagnostics_Record(&logBook->diagnostics, i), sizeof(Diagnostic), &header.bodyHash);
+  }
+  LogCache_Pad(file, header.diagnosticsSize * sizeof(Diagnostic), &header.bodyHash);
+  for (size_t i = 0; i < header.entriesSize; ++i) {
+    const LogEntry* le = &logBook->entries[i];
+    const LogCacheEntry entry = {
+        .timestamp = le->timestamp,
+        .nodeName = le->nodeName,
+        .operation = le->operation,
+        .status = le->status,
+        .dependenciesSize = dependenciesSizes[i],
+    };
+    LogCache_Put(file, &entry, sizeof(entry), &header.bodyHash);
+    for (size_t d = 0; d < entry.dependenciesSize; ++d) {
+      const uint64_t dependency = le->dependencies[d];
+      LogCache_Put(file, &dependency, sizeof(dependency), &header.bodyHash);
+    }
+  }
+  free(dependenciesSizes);
+  rewind(file);
+  fwrite(&header, sizeof(header), 1, file);
+  const bool failed = ferror(file);
+  if (fclose(file) != 0 || failed || rename(temporary, path) != 0) {
+    remove(temporary);
+  }
+}
+
+// Sidecar next to log, or file named by hash of absolute path of log in user cache directory
+static bool LogCache_Path(const char* fileName, bool sidecar, char* path, size_t pathSize) {
+  if (sidecar) {
+    return snprintf(path, pathSize, "%s.dvcache", fileName) < (int)pathSize;
+  }
+  char absolute[PATH_MAX];
+  if (realpath(fileName, absolute) == NULL) {
+    return false;
+  }
+  const char* xdgCache = getenv("XDG_CACHE_HOME");
+  const char* home = getenv("HOME");
+  const uint64_t hash = LogCache_HashString(14695981039346656037ull, absolute);
+  int written = 0;
+  if (xdgCache && *xdgCache) {
+    written = snprintf(path, pathSize, "%s/depview/%016llx.dvcache", xdgCache, (unsigned long long)hash);
+  } else if (home && *home) {
+    written = snprintf(path, pathSize, "%s/.cache/depview/%016llx.dvcache", home, (unsigned long long)hash);
+  } else {
+    return false;
+  }
+  return written > 0 && written < (int)pathSize;
+}
+
+// Temporary file renamed over path once fully written, so reader never maps half written cache
+static FILE* LogCache_Create(const char* fileName, char* path, size_t pathSize, char* temporary, size_t temporarySize) {
+  for (int sidecar = 1; sidecar >= 0; --sidecar) {
+    if (!LogCache_Path(fileName, sidecar, path, pathSize)) {
+      continue;
+    }
+    snprintf(temporary, temporarySize, "%s.tmp", path);
+    FILE* file = fopen(temporary, "wb");
+    if (file == NULL && !sidecar) {
+      for (char* slash = strchr(temporary + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(temporary, 0755);
+        *slash = '/';
+      }
+      file = fopen(temporary, "wb");
+    }
+    if (file) {
+      return file;
+    }
+  }
+  return NULL;
+}
+
+static uint64_t LogCache_Hash(int fd, size_t begin, size_t size) {
+  unsigned char buffer[LOG_CACHE_HASHED_BYTES];
+  const ssize_t got = pread(fd, buffer, size, begin);
+  return LogCache_HashBytes(14695981039346656037ull, buffer, got > 0 ? got : 0);
+}
+
+static uint64_t LogCache_HashString(uint64_t hash, const char* text) {
+  return LogCache_HashBytes(hash, text, strlen(text));
+}
+
+static uint64_t LogCache_HashBytes(uint64_t hash, const void* data, size_t size) {
+  for (const unsigned char* byte = data; byte < (const unsigned char*)data + size; ++byte) {
+    hash = (hash ^ *byte) * 1099511628211ull;  // FNV-1a
+  }
+  return hash;
+}
+
+static void LogCache_Put(FILE* file, const void* data, size_t size, uint64_t* hash) {
+  fwrite(data, 1, size, file);
+  *hash = LogCache_HashBytes(*hash, data, size);
+}
+
+// Unchanged log, or uncompressed one which only got lines appended after parsed position
+static bool LogCache_Matches(const LogCacheHeader* header, const char* fileName, bool compressed) {
+  if (memcmp(header->magic, "DVCACHE", 8) != 0 || header->version != LOG_CACHE_VERSION ||
+      header->recordSize != sizeof(Diagnostic) || header->compressed != compressed) {
+    return false;
+  }
+  const int fd = open(fileName, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat status;
+  bool matches = fstat(fd, &status) == 0 && (size_t)status.st_size >= header->fileSize &&
+                 header->fileSize >= header->bytes;
+  if (matches && (compressed || (size_t)status.st_size == header->fileSize)) {
+    matches = (size_t)status.st_size == header->fileSize && status.st_mtim.tv_sec == header->mtimeSeconds &&
+              status.st_mtim.tv_nsec == header->mtimeNanoseconds;
+  }
+  if (matches) {
+    const size_t hashed = header->bytes < LOG_CACHE_HASHED_BYTES ? header->bytes : LOG_CACHE_HASHED_BYTES;
+    matches = LogCache_Hash(fd, 0, hashed) == header->headHash &&
+              LogCache_Hash(fd, header->bytes - hashed, hashed) == header->tailHash;
+  }
+  close(fd);
+  return matches;
+}
+
+// Names are appended one by one so they get the same offsets they had when log was parsed
+static bool LogCache_Restore(LogBook* logBook, const LogCacheHeader* header, const uint8_t* body, size_t bodySize) {
+  const size_t namesEnd = LogCache_Padded(header->namesBytes);
+  const size_t recordsEnd = namesEnd + LogCache_Padded(header->diagnosticsSize * sizeof(Diagnostic));
+  const size_t entriesEnd =
+      recordsEnd + header->entriesSize * sizeof(LogCacheEntry) + header->dependenciesSize * sizeof(uint64_t);
+  if (entriesEnd != bodySize || header->namesBytes == 0 || header->entriesSize == 0 ||
+      LogCache_HashBytes(14695981039346656037ull, body, bodySize) != header->bodyHash ||
+      body[header->namesBytes - 1] != '\0') {
+    return false;
+  }
+  LogEntry* entries = calloc(header->entriesSize, sizeof(LogEntry));
+  if (entries == NULL) {
+    perror("Cannot calloc memory for LogBook entries");
+    exit(10);
+  }
+  const uint8_t* next = body + recordsEnd;
+  for (LogEntry* le = entries; le < entries + header->entriesSize; ++le) {
+    const LogCacheEntry* entry = (const LogCacheEntry*)next;
+    const uint64_t* dependencies = (const uint64_t*)(entry + 1);
+    next = (const uint8_t*)(dependencies + entry->dependenciesSize);
+    if (next > body + bodySize || entry->nodeName >= header->namesBytes ||
+        entry->dependenciesSize > sizeof(le->dependencies) / sizeof(le->dependencies[0])) {
+      free(entries);
+      return false;
+    }
+    le->timestamp = entry->timestamp;
+    le->nodeName = entry->nodeName;
+    le->operation = entry->operation;
+    le->status = entry->status;
+    for (size_t d = 0; d < entry->dependenciesSize; ++d) {
+      le->dependencies[d] = dependencies[d];
+    }
+  }
+
+  for (const char* name = (const char*)body; name < (const char*)body + header->namesBytes;
+       name += strlen(name) + 1) {
+    StringContainer_Append(&logBook->nodeNames, (char*)name);
+  }
+  size_t counts[EDiagnostic_KindsSize];
+  for (size_t i = 0; i < EDiagnostic_KindsSize; ++i) {
+    counts[i] = header->diagnosticsCounts[i];
+  }
+  Diagnostics_Restore(&logBook->diagnostics, counts, (const Diagnostic*)(body + namesEnd), header->diagnosticsSize);
+  logBook->entries = entries;
+  logBook->entriesSize = header->entriesSize;
+  return true;
+}
+
+static size_t LogCache_Padded(size_t size) {
+  return (size + 7) & ~(size_t)7;
+}
+
+static void LogCache_Pad(FILE* file, size_t size, uint64_t* hash) {
+  static const char zeros[8] = {0};
+  LogCache_Put(file, zeros, LogCache_Padded(size) - size, hash);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Diagnostics.h"
+#include "LogBook.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Point of log up to which it is parsed, always end of complete line
+typedef struct LogCachePosition {
+  size_t bytes;  // of log, or of compressed file
+  size_t lineNumber;
+  size_t entriesSize;
+  size_t namesBytes;  // of nodeNames in use
+  size_t diagnosticsCounts[EDiagnostic_KindsSize];
+  size_t diagnosticsSize;  // records kept
+} LogCachePosition;
+
+bool LogCache_Read(LogBook* logBook, const char* fileName, bool compressed, LogCachePosition* position);
+void LogCache_Write(const LogBook* logBook, const char* fileName, bool compressed, const LogCachePosition* position);
@@ -0,0 +1,207 @@
+#include "NodeIndex.h"
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define NODEINDEX_MAX_QUERY 64
+
+typedef struct NamedOffset {
+  const char* name;
+  size_t offset;
+} NamedOffset;
+
+typedef struct GramPosting {
+  uint32_t key;
+  size_t offset;
+} GramPosting;
+
+static int NodeIndex_CompareNames(const void* lhs, const void* rhs);
+static int NodeIndex_ComparePostings(const void* lhs, const void* rhs);
+static uint32_t NodeIndex_Gram(const char* text, size_t length);
+static bool NodeIndex_Contains(const char* name, const char* loweredQuery, size_t length);
+static void* NodeIndex_Alloc(size_t count, size_t size);
+
+NodeIndex NodeIndex_Init() {
+  return (NodeIndex){
+      .names = NULL,
+      .namesSize = 0,
+      .sorted = NULL,
+      .gramKeys = NULL,
+      .gramsSize = 0,
+      .gramStarts = NULL,
+      .postings = NULL,
+  };
+}
+
+void NodeIndex_Destroy(NodeIndex* this) {
+  free(this->sorted);
+  free(this->gramKeys);
+  free(this->gramStarts);
+  free(this->postings);
+  *this = NodeIndex_Init();
+}
+
+void NodeIndex_Build(NodeIndex* this, const StringContainer* names) {
+  NodeIndex_Destroy(this);
+  const size_t* offsets = DynamicArray_Begin(size_t, names->offsets);
+  const size_t offsetsSize = DynamicArray_Size(size_t, names->offsets);
+  this->names = names->begin;
+  this->namesSize = offsetsSize > 1 ? offsetsSize - 1 : 0;  // first name is placeholder of unknown node
+
+  NamedOffset* named = NodeIndex_Alloc(this->namesSize, sizeof(NamedOffset));
+  size_t postingsSize = 0;
+  for (size_t i = 0; i < this->namesSize; ++i) {
+    named[i] = (NamedOffset){.name = names->begin + offsets[i + 1], .offset = offsets[i + 1]};
+    const size_t length = strlen(named[i].name);
+    postingsSize += length * 3;
+  }
+  qsort(named, this->namesSize, sizeof(NamedOffset), NodeIndex_CompareNames);
+  this->sorted = NodeIndex_Alloc(this->namesSize, sizeof(size_t));
+  for (size_t i = 0; i < this->namesSize; ++i) {
+    this->sorted[i] = named[i].offset;
+  }
+  free(named);
+
+  // every gram of every name, sorted and deduplicated into postings lists
+  GramPosting* all = NodeIndex_Alloc(postingsSize, sizeof(GramPosting));
+  size_t allSize = 0;
+  for (size_t i = 0; i < this->namesSize; ++i) {
+    const char* name = names->begin + offsets[i + 1];
+    for (size_t j = 0; name[j]; ++j) {
+      for (size_t length = 1; length <= 3 && name[j + length - 1]; ++length) {
+        all[allSize++] = (GramPosting){.key = NodeIndex_Gram(name + j, length), .offset = offsets[i + 1]};
+      }
+    }
+  }
+  qsort(all, allSize, sizeof(GramPosting), NodeIndex_ComparePostings);
+
+  this->gramKeys = NodeIndex_Alloc(allSize, sizeof(uint32_t));
+  this->gramStarts = NodeIndex_Alloc(allSize + 1, sizeof(size_t));
+  this->postings = NodeIndex_Alloc(allSize, sizeof(size_t));
+  size_t unique = 0;
+  for (size_t i = 0; i < allSize; ++i) {
+    if (i > 0 && all[i].key == all[i - 1].key && all[i].offset == all[i - 1].offset) {
+      continue;
+    }
+    if (this->gramsSize == 0 || this->gramKeys[this->gramsSize - 1] != all[i].key) {
+      this->gramKeys[this->gramsSize] = all[i].key;
+      this->gramStarts[this->gramsSize] = unique;
+      ++this->gramsSize;
+    }
+    this->postings[unique++] = all[i].offset;
+  }
+  this->gramStarts[this->gramsSize] = unique;
+  free(all);
+}
+
+// Prefix matches come first in alphabetical order, then names containing query elsewhere
+size_t NodeIndex_Search(const NodeIndex* this, const char* query, size_t* results, size_t maxResults) {
+  char lowered[NODEINDEX_MAX_QUERY];
+  size_t length = 0;
+  for (; query[length] && length + 1 < NODEINDEX_MAX_QUERY; ++length) {
+    lowered[length] = tolower((unsigned char)query[length]);
+  }
+  lowered[length] = '\0';
+  if (length == 0 || maxResults == 0 || this->namesSize == 0) {
+    return 0;
+  }
+
+  size_t low = 0;
+  size_t high = this->namesSize;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (strncasecmp(this->names + this->sorted[middle], lowered, length) < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  size_t found = 0;
+  for (size_t i = low; i < this->namesSize && found < maxResults; ++i) {
+    if (strncasecmp(this->names + this->sorted[i], lowered, length) != 0) {
+      break;
+    }
+    results[found++] = this->sorted[i];
+  }
+
+  // candidates for substring match: names sharing the rarest trigram of query, or whole query when it is shorter
+  const size_t* candidates = NULL;
+  size_t candidatesSize = 0;
+  const size_t gramLength = length < 3 ? length : 3;
+  for (size_t j = 0; j + gramLength <= length; ++j) {
+    const uint32_t key = NodeIndex_Gram(lowered + j, gramLength);
+    size_t lowKey = 0;
+    size_t highKey = this->gramsSize;
+    while (lowKey < highKey) {
+      const size_t middle = lowKey + (highKey - lowKey) / 2;
+      if (this->gramKeys[middle] < key) {
+        lowKey = middle + 1;
+      } else {
+        highKey = middle;
+      }
+    }
+    if (lowKey == this->gramsSize || this->gramKeys[lowKey] != key) {
+      return found;
+    }
+    const size_t postingsSize = this->gramStarts[lowKey + 1] - this->gramStarts[lowKey];
+    if (candidates == NULL || postingsSize < candidatesSize) {
+      candidates = this->postings + this->gramStarts[lowKey];
+      candidatesSize = postingsSize;
+    }
+  }
+  for (size_t i = 0; i < candidatesSize && found < maxResults; ++i) {
+    const char* name = this->names + candidates[i];
+    if (strncasecmp(name, lowered, length) != 0 && NodeIndex_Contains(name, lowered, length)) {
+      results[found++] = candidates[i];
+    }
+  }
+  return found;
+}
+
+static int NodeIndex_CompareNames(const void* lhs, const void* rhs) {
+  return strcasecmp(((const NamedOffset*)lhs)->name, ((const NamedOffset*)rhs)->name);
+}
+
+static int NodeIndex_ComparePostings(const void* lhs, const void* rhs) {
+  const GramPosting* left = lhs;
+  const GramPosting* right = rhs;
+  if (left->key != right->key) {
+    return left->key < right->key ? -1 : 1;
+  }
+  return left->offset < right->offset ? -1 : left->offset > right->offset;
+}
+
+// Length in top byte keeps grams of different lengths apart
+static uint32_t NodeIndex_Gram(const char* text, size_t length) {
+  uint32_t key = (uint32_t)length << 24;
+  for (size_t i = 0; i < length; ++i) {
+    key |= (uint32_t)tolower((unsigned char)text[i]) << (16 - 8 * i);
+  }
+  return key;
+}
+
+static bool NodeIndex_Contains(const char* name, const char* loweredQuery, size_t length) {
+  for (; *name; ++name) {
+    size_t i = 0;
+    while (i < length && name[i] && tolower((unsigned char)name[i]) == loweredQuery[i]) {
+      ++i;
+    }
+    if (i == length) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void* NodeIndex_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for NodeIndex");
+    exit(10);
+  }
+  return memory;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "StringContainer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Case insensitive search over interned node names. Results are name offsets, as kept in Node.nodeName.
+typedef struct NodeIndex {
+  const char* names;      // StringContainer storage the offsets point into
+  size_t namesSize;
+  size_t* sorted;         // name offsets in case insensitive order, for prefix lookup
+  uint32_t* gramKeys;     // distinct lowercase 1, 2 and 3 character grams, ascending
+  size_t gramsSize;
+  size_t* gramStarts;     // gramsSize + 1 offsets into postings
+  size_t* postings;       // name offsets containing given gram
+} NodeIndex;
+
+NodeIndex NodeIndex_Init();
+void NodeIndex_Destroy(NodeIndex* this);
+void NodeIndex_Build(NodeIndex* this, const StringContainer* names);
+size_t NodeIndex_Search(const NodeIndex* this, const char* query, size_t* results, size_t maxResults);
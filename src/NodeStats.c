@@ -0,0 +1,219 @@
+#include "NodeStats.h"
+#include "LogBook.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct NodeEvent {
+  size_t node;
+  NodeChange change;
+} NodeEvent;
+
+static size_t NodeStats_Bucket(time_t seconds);
+static void NodeStats_SiftDown(const NodeStats* this, int key, size_t* heap, size_t size, size_t i);
+static void* NodeStats_Alloc(size_t count, size_t size);
+
+NodeStats NodeStats_Init() {
+  return (NodeStats){
+      .nodesSize = 0,
+      .nodeNames = NULL,
+      .nodeOfName = NULL,
+      .entryNodes = NULL,
+      .removed = NULL,
+      .changeStarts = NULL,
+      .changes = NULL,
+      .durations = NULL,
+      .histograms = {{0}},
+      .begin = 0,
+      .end = 0,
+  };
+}
+
+void NodeStats_Destroy(NodeStats* this) {
+  free(this->nodeNames);
+  free(this->nodeOfName);
+  free(this->entryNodes);
+  free(this->removed);
+  free(this->changeStarts);
+  free(this->changes);
+  free(this->durations);
+  *this = NodeStats_Init();
+}
+
+void NodeStats_Build(NodeStats* this, const LogBook* logBook) {
+  NodeStats_Destroy(this);
+  const size_t namesSize = DynamicArray_Size(size_t, logBook->nodeNames.offsets);
+  this->nodeNames = NodeStats_Alloc(namesSize, sizeof(size_t));
+  this->removed = NodeStats_Alloc(namesSize, sizeof(time_t));
+
+  // name offsets point into bytes of names, so node of offset is found directly
+  this->nodeOfName = NodeStats_Alloc(logBook->nodeNames.end - logBook->nodeNames.begin, sizeof(uint32_t));
+  this->entryNodes = NodeStats_Alloc(logBook->entriesSize, sizeof(size_t));
+  NodeEvent* events = NodeStats_Alloc(logBook->entriesSize, sizeof(NodeEvent));
+  size_t eventsSize = 0;
+  bool timed = false;  // begin and end are set
+  for (size_t i = 0; i < logBook->entriesSize; ++i) {
+    const LogEntry* entry = &logBook->entries[i];
+    // entries need not be in time order, and line with wrong timestamp has 0
+    if (entry->timestamp != 0) {
+      this->begin = !timed || entry->timestamp < this->begin ? entry->timestamp : this->begin;
+      this->end = !timed || entry->timestamp > this->end ? entry->timestamp : this->end;
+      timed = true;
+    }
+    if (entry->operation == EOperation_Add) {
+      if (this->nodeOfName[entry->nodeName] == 0) {
+        this->nodeOfName[entry->nodeName] = this->nodesSize + 1;
+      }
+      this->nodeNames[this->nodesSize++] = entry->nodeName;
+    }
+    const size_t node = this->nodeOfName[entry->nodeName];
+    this->entryNodes[i] = node - 1;
+    if (node == 0) {
+      continue;  // unknown node has already been reported by parser
+    }
+    if (entry->operation == EOperation_Add || entry->operation == EOperation_StatusChange) {
+      events[eventsSize++] = (NodeEvent){node - 1, {entry->timestamp, i, entry->status}};
+    } else if (entry->operation == EOperation_Remove) {
+      this->removed[node - 1] = entry->timestamp;
+    }
+  }
+
+  // counting sort of events by node keeps them in time order
+  this->changeStarts = NodeStats_Alloc(this->nodesSize + 1, sizeof(size_t));
+  for (size_t i = 0; i < eventsSize; ++i) {
+    ++this->changeStarts[events[i].node + 1];
+  }
+  for (size_t i = 0; i < this->nodesSize; ++i) {
+    this->changeStarts[i + 1] += this->changeStarts[i];
+  }
+  this->changes = NodeStats_Alloc(eventsSize, sizeof(NodeChange));
+  size_t* cursor = NodeStats_Alloc(this->nodesSize, sizeof(size_t));
+  for (size_t i = 0; i < eventsSize; ++i) {
+    const size_t node = events[i].node;
+    this->changes[this->changeStarts[node] + cursor[node]++] = events[i].change;
+  }
+  free(cursor);
+  free(events);
+
+  this->durations = NodeStats_Alloc(this->nodesSize * NODESTATS_KEYS, sizeof(time_t));
+  for (size_t node = 0; node < this->nodesSize; ++node) {
+    const NodeChange* first = this->changes + this->changeStarts[node];
+    const NodeChange* last = this->changes + this->changeStarts[node + 1];
+    const time_t end = this->removed[node] ? this->removed[node] : this->end;
+    time_t* durations = this->durations + node * NODESTATS_KEYS;
+    int visited = 0;  // bit per status
+    for (const NodeChange* it = first; it < last; ++it) {
+      const time_t until = it + 1 < last ? it[1].timestamp : end;
+      durations[it->status] += until > it->timestamp ? until - it->timestamp : 0;
+      visited |= 1 << it->status;
+    }
+    durations[NODESTATS_LIFETIME] = first < last && end > first->timestamp ? end - first->timestamp : 0;
+    for (int status = 0; status < NODESTATS_STATUSES; ++status) {
+      if (visited & (1 << status)) {
+        ++this->histograms[status][NodeStats_Bucket(durations[status])];
+      }
+    }
+  }
+}
+
+time_t NodeStats_Duration(const NodeStats* this, size_t node, int key) {
+  return this->durations[node * NODESTATS_KEYS + key];
+}
+
+// Status of node in snapshot at entry, -1 when node has not been added yet
+int NodeStats_StatusAt(const NodeStats* this, size_t node, size_t entry) {
+  size_t low = this->changeStarts[node];
+  size_t high = this->changeStarts[node + 1];
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (this->changes[middle].entry <= entry) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low > this->changeStarts[node] ? this->changes[low - 1].status : -1;
+}
+
+// Nodes with the longest durations of given key, longest first. Min-heap of maxResults keeps it linear in nodes.
+size_t NodeStats_Top(const NodeStats* this, int key, size_t* result, size_t maxResults) {
+  size_t size = 0;
+  for (size_t node = 0; node < this->nodesSize; ++node) {
+    if (size < maxResults) {
+      result[size++] = node;
+      if (size == maxResults) {
+        for (size_t i = size / 2; i-- > 0;) {
+          NodeStats_SiftDown(this, key, result, size, i);
+        }
+      }
+    } else if (maxResults > 0 && NodeStats_Duration(this, node, key) > NodeStats_Duration(this, result[0], key)) {
+      result[0] = node;
+      NodeStats_SiftDown(this, key, result, size, 0);
+    }
+  }
+  if (size < maxResults) {
+    for (size_t i = size / 2; i-- > 0;) {
+      NodeStats_SiftDown(this, key, result, size, i);
+    }
+  }
+  // heap sort leaves the shortest at the end
+  for (size_t end = size; end > 1; --end) {
+    const size_t swap = result[0];
+    result[0] = result[end - 1];
+    result[end - 1] = swap;
+    NodeStats_SiftDown(this, key, result, end - 1, 0);
+  }
+  return size;
+}
+
+void NodeStats_FormatDuration(time_t seconds, char* text, size_t size) {
+  const long long h = seconds / 3600;
+  const int m = seconds / 60 % 60;
+  const int s = seconds % 60;
+  if (h > 0) {
+    snprintf(text, size, "%lldh%02dm%02ds", h, m, s);
+  } else if (m > 0) {
+    snprintf(text, size, "%dm%02ds", m, s);
+  } else {
+    snprintf(text, size, "%ds", s);
+  }
+}
+
+static size_t NodeStats_Bucket(time_t seconds) {
+  size_t bucket = 0;
+  while (seconds > 0 && bucket + 1 < NODESTATS_BUCKETS) {
+    seconds >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+static void NodeStats_SiftDown(const NodeStats* this, int key, size_t* heap, size_t size, size_t i) {
+  for (;;) {
+    size_t smallest = i;
+    for (size_t child = 2 * i + 1; child <= 2 * i + 2 && child < size; ++child) {
+      if (NodeStats_Duration(this, heap[child], key) < NodeStats_Duration(this, heap[smallest], key)) {
+        smallest = child;
+      }
+    }
+    if (smallest == i) {
+      return;
+    }
+    const size_t swap = heap[i];
+    heap[i] = heap[smallest];
+    heap[smallest] = swap;
+    i = smallest;
+  }
+}
+
+static void* NodeStats_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for NodeStats");
+    exit(10);
+  }
+  return memory;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#define NODESTATS_STATUSES 3  // EStatus_Waiting, EStatus_Ongoing, EStatus_Finished
+#define NODESTATS_LIFETIME NODESTATS_STATUSES
+#define NODESTATS_KEYS (NODESTATS_STATUSES + 1)  // time spent in every status, then whole lifetime
+#define NODESTATS_BUCKETS 24                     // bucket b > 0 holds durations from 2^(b-1) to 2^b seconds
+
+typedef struct LogBook LogBook;
+
+typedef struct NodeChange {
+  time_t timestamp;
+  size_t entry;  // which set the status
+  int status;
+} NodeChange;
+
+// Lifetimes of nodes, collected in one pass over log entries. Node is identified by order of its addition, as in
+// Graph.nodes, and a name always refers to the first node added with it, as in Graph.
+typedef struct NodeStats {
+  size_t nodesSize;
+  size_t* nodeNames;     // name offset of node
+  uint32_t* nodeOfName;  // 1 + node of name offset, 0 when name has not been added
+  size_t* entryNodes;    // node of every log entry, (size_t)-1 when unknown
+  time_t* removed;       // 0 when node has not been removed
+  size_t* changeStarts;  // nodesSize + 1 offsets into changes
+  NodeChange* changes;   // statuses of node in time order, first one set by its addition
+  time_t* durations;     // NODESTATS_KEYS per node, in seconds
+  size_t histograms[NODESTATS_STATUSES][NODESTATS_BUCKETS];  // nodes which spent given time in status
+  time_t begin;  // earliest valid timestamp of entries
+  time_t end;    // latest one
+} NodeStats;
+
+NodeStats NodeStats_Init();
+void NodeStats_Destroy(NodeStats* this);
+void NodeStats_Build(NodeStats* this, const LogBook* logBook);
+time_t NodeStats_Duration(const NodeStats* this, size_t node, int key);
+int NodeStats_StatusAt(const NodeStats* this, size_t node, size_t entry);
+size_t NodeStats_Top(const NodeStats* this, int key, size_t* result, size_t maxResults);
+void NodeStats_FormatDuration(time_t seconds, char* text, size_t size);
@@ -0,0 +1,146 @@
+#include "Profiler.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#define PROFILER_RING_SIZE 4096  // must be power of 2
+
+typedef struct ProfilerSlot {
+  atomic_size_t sequence;
+  ProfilerEvent event;
+} ProfilerSlot;
+
+// Bounded multi-producer single-consumer queue. Producers never wait: when ring is full event is dropped.
+static ProfilerSlot ring[PROFILER_RING_SIZE];
+static atomic_size_t ringHead;
+static size_t ringTail;
+static atomic_size_t dropped;
+static atomic_uint threadsCount;
+static _Thread_local unsigned int threadId = (unsigned int)-1;
+
+static atomic_size_t counters[ECounter_Size];
+static ProfilerStats stats[EPhase_Size];
+static ProfilerSink sink;
+static uint64_t origin;
+
+static const char* const PHASE_NAMES[EPhase_Size] = {
+    "frame", "load", "graph change", "layout", "draw diagram", "draw framelist", "draw timeline", "render", "encode",
+};
+
+static unsigned int Profiler_ThreadId();
+
+void Profiler_Init() {
+  for (size_t i = 0; i < PROFILER_RING_SIZE; ++i) {
+    atomic_init(&ring[i].sequence, i);
+  }
+  atomic_init(&ringHead, 0);
+  ringTail = 0;
+  atomic_init(&dropped, 0);
+  atomic_init(&threadsCount, 0);
+  for (size_t i = 0; i < ECounter_Size; ++i) {
+    atomic_init(&counters[i], 0);
+  }
+  for (size_t i = 0; i < EPhase_Size; ++i) {
+    stats[i] = (ProfilerStats){.lastMs = 0, .averageMs = 0, .maxMs = 0, .calls = 0};
+  }
+  sink = NULL;
+  origin = Profiler_Now();
+  Profiler_ThreadId();  // calling thread gets id 0
+}
+
+uint64_t Profiler_Now() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+void Profiler_Record(EPhase phase, uint64_t begin, uint64_t end) {
+  size_t position = atomic_load_explicit(&ringHead, memory_order_relaxed);
+  ProfilerSlot* slot;
+  for (;;) {
+    slot = &ring[position & (PROFILER_RING_SIZE - 1)];
+    const size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+    if (sequence == position) {
+      if (atomic_compare_exchange_weak_explicit(&ringHead, &position, position + 1, memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        break;
+      }
+    } else if (sequence < position) {
+      atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+      return;
+    } else {
+      position = atomic_load_explicit(&ringHead, memory_order_relaxed);
+    }
+  }
+  slot->event = (ProfilerEvent){.phase = phase, .thread = Profiler_ThreadId(), .begin = begin, .end = end};
+  atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+}
+
+ProfilerScope Profiler_BeginScope(EPhase phase) {
+  return (ProfilerScope){.phase = phase, .begin = Profiler_Now()};
+}
+
+void Profiler_EndScope(ProfilerScope* scope) {
+  Profiler_Record(scope->phase, scope->begin, Profiler_Now());
+}
+
+void Profiler_SetCounter(ECounter counter, size_t value) {
+  atomic_store_explicit(&counters[counter], value, memory_order_relaxed);
+}
+
+// Drains the ring into per-phase statistics. Must be called from one thread only.
+void Profiler_Collect() {
+  for (;;) {
+    ProfilerSlot* slot = &ring[ringTail & (PROFILER_RING_SIZE - 1)];
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != ringTail + 1) {
+      break;
+    }
+    const ProfilerEvent event = slot->event;
+    atomic_store_explicit(&slot->sequence, ringTail + PROFILER_RING_SIZE, memory_order_release);
+    ++ringTail;
+    if (sink) {
+      sink(&event);
+    }
+
+    ProfilerStats* phaseStats = &stats[event.phase];
+    phaseStats->lastMs = (event.end - event.begin) / 1e6;
+    phaseStats->averageMs =
+        phaseStats->calls == 0 ? phaseStats->lastMs : phaseStats->averageMs * 0.95 + phaseStats->lastMs * 0.05;
+    phaseStats->maxMs = phaseStats->lastMs > phaseStats->maxMs ? phaseStats->lastMs : phaseStats->maxMs;
+    ++phaseStats->calls;
+  }
+}
+
+// Sink is called by Profiler_Collect for every drained event, on the collecting thread
+void Profiler_SetSink(ProfilerSink newSink) {
+  sink = newSink;
+}
+
+uint64_t Profiler_GetOrigin() {
+  return origin;
+}
+
+const char* Profiler_PhaseName(EPhase phase) {
+  return PHASE_NAMES[phase];
+}
+
+ProfilerStats Profiler_GetStats(EPhase phase) {
+  return stats[phase];
+}
+
+size_t Profiler_GetCounter(ECounter counter) {
+  return atomic_load_explicit(&counters[counter], memory_order_relaxed);
+}
+
+size_t Profiler_GetDropped() {
+  return atomic_load_explicit(&dropped, memory_order_relaxed);
+}
+
+static unsigned int Profiler_ThreadId() {
+  if (threadId == (unsigned int)-1) {
+    threadId = atomic_fetch_add(&threadsCount, 1);
+  }
+  return threadId;
+}
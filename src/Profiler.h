@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+  EPhase_Frame,
+  EPhase_Load,
+  EPhase_GraphChange,
+  EPhase_BuildLayout,
+  EPhase_DrawDiagram,
+  EPhase_DrawFrameList,
+  EPhase_DrawTimeline,
+  EPhase_Render,
+  EPhase_Encode,
+  EPhase_Size
+} EPhase;
+
+typedef enum { ECounter_Nodes, ECounter_Edges, ECounter_Entries, ECounter_Size } ECounter;
+
+typedef struct ProfilerEvent {
+  EPhase phase;
+  unsigned int thread;
+  uint64_t begin;  // nanoseconds of monotonic clock
+  uint64_t end;
+} ProfilerEvent;
+
+typedef struct ProfilerStats {
+  double lastMs;
+  double averageMs;
+  double maxMs;
+  size_t calls;
+} ProfilerStats;
+
+typedef void (*ProfilerSink)(const ProfilerEvent* event);
+
+typedef struct ProfilerScope {
+  EPhase phase;
+  uint64_t begin;
+} ProfilerScope;
+
+void Profiler_Init();
+uint64_t Profiler_Now();
+void Profiler_Record(EPhase phase, uint64_t begin, uint64_t end);
+ProfilerScope Profiler_BeginScope(EPhase phase);
+void Profiler_EndScope(ProfilerScope* scope);
+void Profiler_SetCounter(ECounter counter, size_t value);
+void Profiler_Collect();
+void Profiler_SetSink(ProfilerSink sink);
+uint64_t Profiler_GetOrigin();
+
+const char* Profiler_PhaseName(EPhase phase);
+ProfilerStats Profiler_GetStats(EPhase phase);
+size_t Profiler_GetCounter(ECounter counter);
+size_t Profiler_GetDropped();
+
+// With DEPVIEW_PROFILER undefined instrumentation compiles to nothing
+#ifdef DEPVIEW_PROFILER
+#define PROFILER_SCOPE(phase) \
+  ProfilerScope profilerScope __attribute__((cleanup(Profiler_EndScope))) = Profiler_BeginScope(phase)
+#define PROFILER_COUNTER(counter, value) Profiler_SetCounter(counter, value)
+#define PROFILER_COLLECT() Profiler_Collect()
+#define PROFILER_INIT() Profiler_Init()
+#else
+#define PROFILER_SCOPE(phase)
+#define PROFILER_COUNTER(counter, value)
+#define PROFILER_COLLECT()
+#define PROFILER_INIT()
+#endif
@@ -0,0 +1,231 @@
+#include "Reachability.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t Reachability_Root(size_t* parents, size_t node);
+static const uint64_t* Reachability_Closure(Reachability* this, const Graph* graph, size_t component);
+static size_t Reachability_Walk(Reachability* this, const Graph* graph, size_t node, EReach query, Bitset* result);
+static size_t Reachability_Visit(Reachability* this, const Graph* graph, size_t node, Bitset* result);
+static size_t Reachability_WordsSize(size_t bits);
+static void* Reachability_Alloc(size_t count, size_t size);
+
+Reachability Reachability_Init() {
+  return (Reachability){
+      .nodesSize = 0,
+      .dependents = {.starts = NULL, .nodes = NULL},
+      .componentsSize = 0,
+      .componentOf = NULL,
+      .componentStarts = NULL,
+      .members = NULL,
+      .rank = NULL,
+      .acyclic = NULL,
+      .closures = NULL,
+      .visited = Bitset_Init(),
+      .stack = NULL,
+  };
+}
+
+void Reachability_Destroy(Reachability* this) {
+  Graph_DestroyDependents(&this->dependents);
+  for (size_t i = 0; this->closures && i < this->componentsSize; ++i) {
+    free(this->closures[i]);
+  }
+  free(this->closures);
+  free(this->componentOf);
+  free(this->componentStarts);
+  free(this->members);
+  free(this->rank);
+  free(this->acyclic);
+  Bitset_Destroy(&this->visited);
+  if (this->stack) {
+    DynamicArray_Destroy(this->stack);
+    free(this->stack);
+  }
+  *this = Reachability_Init();
+}
+
+// Components and topological order are found once per graph, closures are left for queries
+void Reachability_Index(Reachability* this, const Graph* graph) {
+  Reachability_Destroy(this);
+  const size_t nodesSize = graph->nodesSize;
+  this->nodesSize = nodesSize;
+  this->dependents = Graph_Dependents(graph);
+  this->stack = DynamicArray_Make(size_t);
+  Bitset_Resize(&this->visited, nodesSize);
+
+  // weakly connected components by union-find over edges
+  size_t* parents = Reachability_Alloc(nodesSize, sizeof(size_t));
+  for (size_t i = 0; i < nodesSize; ++i) {
+    parents[i] = i;
+  }
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    parents[Reachability_Root(parents, edge->source)] = Reachability_Root(parents, edge->destination);
+  }
+  this->componentOf = Reachability_Alloc(nodesSize, sizeof(size_t));
+  for (size_t i = 0; i < nodesSize; ++i) {
+    this->componentOf[i] = Reachability_Root(parents, i);
+  }
+  for (size_t i = 0; i < nodesSize; ++i) {
+    if (this->componentOf[i] == i) {
+      parents[i] = this->componentsSize++;  // forest is not needed anymore, roots get numbers of components
+    }
+  }
+  for (size_t i = 0; i < nodesSize; ++i) {
+    this->componentOf[i] = parents[this->componentOf[i]];
+  }
+  free(parents);
+
+  // nodes left out of topological order lie on cycles or depend on them
+  size_t* order = Reachability_Alloc(nodesSize, sizeof(size_t));
+  const size_t sortedSize = Graph_TopologicalOrder(graph, &this->dependents, order);
+  this->acyclic = Reachability_Alloc(this->componentsSize, sizeof(bool));
+  memset(this->acyclic, true, this->componentsSize * sizeof(bool));
+  for (size_t i = sortedSize; i < nodesSize; ++i) {
+    this->acyclic[this->componentOf[order[i]]] = false;
+  }
+
+  // counting sort of nodes by component, keeping topological order inside
+  this->componentStarts = Reachability_Alloc(this->componentsSize + 1, sizeof(size_t));
+  for (size_t i = 0; i < nodesSize; ++i) {
+    ++this->componentStarts[this->componentOf[i] + 1];
+  }
+  for (size_t c = 0; c < this->componentsSize; ++c) {
+    this->componentStarts[c + 1] += this->componentStarts[c];
+  }
+  this->members = Reachability_Alloc(nodesSize, sizeof(size_t));
+  this->rank = Reachability_Alloc(nodesSize, sizeof(size_t));
+  size_t* cursor = Reachability_Alloc(this->componentsSize, sizeof(size_t));
+  for (size_t i = 0; i < nodesSize; ++i) {
+    const size_t node = order[i];
+    const size_t component = this->componentOf[node];
+    this->rank[node] = cursor[component]++;
+    this->members[this->componentStarts[component] + this->rank[node]] = node;
+  }
+  free(cursor);
+  free(order);
+  this->closures = Reachability_Alloc(this->componentsSize, sizeof(uint64_t*));
+}
+
+// Unfinished nodes which given node transitively depends on, or which transitively depend on it
+size_t Reachability_Query(Reachability* this, const Graph* graph, size_t node, EReach query, Bitset* result) {
+  Bitset_Resize(result, graph->nodesSize);
+  if (node >= this->nodesSize || query == EReach_None) {
+    return 0;
+  }
+  const size_t component = this->componentOf[node];
+  const uint64_t* closure = Reachability_Closure(this, graph, component);
+  if (closure == NULL) {
+    return Reachability_Walk(this, graph, node, query, result);
+  }
+
+  const size_t* members = this->members + this->componentStarts[component];
+  const size_t membersSize = this->componentStarts[component + 1] - this->componentStarts[component];
+  const size_t wordsSize = Reachability_WordsSize(membersSize);
+  const size_t rank = this->rank[node];
+  size_t found = 0;
+  if (query == EReach_Blockers) {
+    // ancestors precede node in topological order, so only the first words of its row can be set
+    const Bitset row = {.words = (uint64_t*)closure + rank * wordsSize, .size = rank};
+    for (size_t r = Bitset_Next(&row, 0); r < rank; r = Bitset_Next(&row, r + 1)) {
+      if (graph->nodes[members[r]].status != EStatus_Finished) {
+        Bitset_Set(result, members[r]);
+        ++found;
+      }
+    }
+  } else {
+    for (size_t r = rank + 1; r < membersSize; ++r) {
+      if ((closure[r * wordsSize + rank / 64] >> (rank % 64)) & 1 &&
+          graph->nodes[members[r]].status != EStatus_Finished) {
+        Bitset_Set(result, members[r]);
+        ++found;
+      }
+    }
+  }
+  return found;
+}
+
+static size_t Reachability_Root(size_t* parents, size_t node) {
+  while (parents[node] != node) {
+    parents[node] = parents[parents[node]];  // path halving
+    node = parents[node];
+  }
+  return node;
+}
+
+// Row of member has bits of all its ancestors. Members come in topological order, so rows of dependencies are
+// complete when dependent is reached and only their lower-triangle words need to be merged.
+static const uint64_t* Reachability_Closure(Reachability* this, const Graph* graph, size_t component) {
+  const size_t membersSize = this->componentStarts[component + 1] - this->componentStarts[component];
+  if (!this->acyclic[component] || membersSize > REACHABILITY_MAX_CLOSURE || membersSize < 2) {
+    return NULL;
+  }
+  if (this->closures[component]) {
+    return this->closures[component];
+  }
+  const size_t* members = this->members + this->componentStarts[component];
+  const size_t wordsSize = Reachability_WordsSize(membersSize);
+  uint64_t* closure = Reachability_Alloc(membersSize * wordsSize, sizeof(uint64_t));
+  for (size_t k = 0; k < membersSize; ++k) {
+    uint64_t* row = closure + k * wordsSize;
+    for (const size_t* it = graph->nodes[members[k]].dependencies; *it != (size_t)-1; ++it) {
+      const size_t dependency = this->rank[*it];
+      const uint64_t* dependencyRow = closure + dependency * wordsSize;
+      for (size_t w = 0; w <= dependency / 64; ++w) {
+        row[w] |= dependencyRow[w];
+      }
+      row[dependency / 64] |= (uint64_t)1 << (dependency % 64);
+    }
+  }
+  this->closures[component] = closure;
+  return closure;
+}
+
+// Depth first walk for components without closure
+static size_t Reachability_Walk(Reachability* this, const Graph* graph, size_t node, EReach query, Bitset* result) {
+  Bitset_Clear(&this->visited);
+  Bitset_Set(&this->visited, node);
+  DynamicArray_Push(this->stack, node);
+  size_t found = 0;
+  while (DynamicArray_Size(size_t, this->stack) != 0) {
+    const size_t current = *DynamicArray_Pop(size_t, this->stack);
+    if (query == EReach_Blockers) {
+      for (const size_t* it = graph->nodes[current].dependencies; *it != (size_t)-1; ++it) {
+        found += Reachability_Visit(this, graph, *it, result);
+      }
+    } else {
+      const size_t* end = this->dependents.nodes + this->dependents.starts[current + 1];
+      for (const size_t* it = this->dependents.nodes + this->dependents.starts[current]; it < end; ++it) {
+        found += Reachability_Visit(this, graph, *it, result);
+      }
+    }
+  }
+  return found;
+}
+
+static size_t Reachability_Visit(Reachability* this, const Graph* graph, size_t node, Bitset* result) {
+  if (Bitset_Test(&this->visited, node)) {
+    return 0;
+  }
+  Bitset_Set(&this->visited, node);
+  DynamicArray_Push(this->stack, node);
+  if (graph->nodes[node].status == EStatus_Finished) {
+    return 0;
+  }
+  Bitset_Set(result, node);
+  return 1;
+}
+
+static size_t Reachability_WordsSize(size_t bits) {
+  return (bits + 63) / 64;
+}
+
+static void* Reachability_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for Reachability");
+    exit(10);
+  }
+  return memory;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Bitset.h"
+#include "DynamicArray.h"
+#include "Graph.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define REACHABILITY_MAX_CLOSURE 4096  // bigger or cyclic components are walked on every query instead
+
+typedef enum { EReach_None, EReach_Blockers, EReach_Unblocks } EReach;
+
+// Transitive dependencies and dependents of nodes. Closure of weakly connected component is built on first query
+// touching it, as bit matrix with ancestors of every member in its row.
+typedef struct Reachability {
+  size_t nodesSize;  // of graph index was built for
+  Dependents dependents;
+  size_t componentsSize;
+  size_t* componentOf;
+  size_t* componentStarts;  // componentsSize + 1 offsets into members
+  size_t* members;          // nodes grouped by component, in topological order when component is acyclic
+  size_t* rank;             // position of node among members of its component
+  bool* acyclic;
+  uint64_t** closures;  // per component, NULL until needed
+  Bitset visited;
+  DynamicArray* stack;
+} Reachability;
+
+Reachability Reachability_Init();
+void Reachability_Destroy(Reachability* this);
+void Reachability_Index(Reachability* this, const Graph* graph);
+size_t Reachability_Query(Reachability* this, const Graph* graph, size_t node, EReach query, Bitset* result);
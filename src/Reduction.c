@@ -0,0 +1,114 @@
+#include "Reduction.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void Reduction_Node(Reduction* this, const Graph* graph, size_t node, const size_t* incoming, size_t size);
+static void* Reduction_Alloc(size_t count, size_t size);
+
+Reduction Reduction_Init() {
+  return (Reduction){
+      .redundant = Bitset_Init(),
+      .redundantSize = 0,
+      .rank = NULL,
+      .visited = NULL,
+      .target = NULL,
+      .stack = NULL,
+  };
+}
+
+void Reduction_Destroy(Reduction* this) {
+  Bitset_Destroy(&this->redundant);
+  free(this->rank);
+  free(this->visited);
+  free(this->target);
+  if (this->stack) {
+    DynamicArray_Destroy(this->stack);
+    free(this->stack);
+  }
+  *this = Reduction_Init();
+}
+
+void Reduction_Build(Reduction* this, const Graph* graph) {
+  Reduction_Destroy(this);
+  const size_t nodesSize = graph->nodesSize;
+  Bitset_Resize(&this->redundant, graph->edgesSize);
+  this->rank = Reduction_Alloc(nodesSize, sizeof(size_t));
+  this->visited = Reduction_Alloc(nodesSize, sizeof(size_t));
+  this->target = Reduction_Alloc(nodesSize, sizeof(size_t));
+  this->stack = DynamicArray_Make(size_t);
+
+  Dependents dependents = Graph_Dependents(graph);
+  size_t* order = Reduction_Alloc(nodesSize, sizeof(size_t));
+  const size_t sortedSize = Graph_TopologicalOrder(graph, &dependents, order);
+  Graph_DestroyDependents(&dependents);
+  for (size_t i = 0; i < nodesSize; ++i) {
+    this->rank[order[i]] = i;
+  }
+
+  // incoming edges grouped by destination
+  size_t* starts = Reduction_Alloc(nodesSize + 1, sizeof(size_t));
+  size_t* incoming = Reduction_Alloc(graph->edgesSize, sizeof(size_t));
+  for (const Edge* edge = graph->edges; edge < graph->edges + graph->edgesSize; ++edge) {
+    ++starts[edge->destination + 1];
+  }
+  for (size_t i = 0; i < nodesSize; ++i) {
+    starts[i + 1] += starts[i];
+  }
+  size_t* cursor = Reduction_Alloc(nodesSize, sizeof(size_t));
+  for (size_t e = 0; e < graph->edgesSize; ++e) {
+    const size_t destination = graph->edges[e].destination;
+    incoming[starts[destination] + cursor[destination]++] = e;
+  }
+  free(cursor);
+
+  // ancestors of sorted node are sorted as well, so walks below never enter a cycle
+  for (size_t i = 0; i < sortedSize; ++i) {
+    const size_t node = order[i];
+    if (starts[node + 1] - starts[node] > 1) {
+      Reduction_Node(this, graph, node, incoming + starts[node], starts[node + 1] - starts[node]);
+    }
+  }
+  free(starts);
+  free(incoming);
+  free(order);
+}
+
+// Walks up from every dependency of node. Dependencies met on the way are reachable without their direct edge.
+// Ancestors ranked before the earliest dependency cannot lead to any of them, so walks stop there.
+static void Reduction_Node(Reduction* this, const Graph* graph, size_t node, const size_t* incoming, size_t size) {
+  const size_t stamp = node + 1;
+  size_t minRank = (size_t)-1;
+  for (size_t j = 0; j < size; ++j) {
+    const size_t dependency = graph->edges[incoming[j]].source;
+    this->target[dependency] = incoming[j] + 1;
+    minRank = this->rank[dependency] < minRank ? this->rank[dependency] : minRank;
+  }
+  for (size_t j = 0; j < size; ++j) {
+    DynamicArray_Push(this->stack, graph->edges[incoming[j]].source);
+    while (DynamicArray_Size(size_t, this->stack) != 0) {
+      const size_t current = *DynamicArray_Pop(size_t, this->stack);
+      for (const size_t* it = graph->nodes[current].dependencies; *it != (size_t)-1; ++it) {
+        if (this->visited[*it] == stamp || this->rank[*it] < minRank) {
+          continue;
+        }
+        this->visited[*it] = stamp;
+        DynamicArray_Push(this->stack, *it);
+        const size_t edge = this->target[*it];
+        if (edge != 0 && graph->edges[edge - 1].destination == node && !Bitset_Test(&this->redundant, edge - 1)) {
+          Bitset_Set(&this->redundant, edge - 1);
+          ++this->redundantSize;
+        }
+      }
+    }
+  }
+}
+
+static void* Reduction_Alloc(size_t count, size_t size) {
+  void* memory = calloc(count ? count : 1, size);
+  if (memory == NULL) {
+    perror("Cannot calloc memory for Reduction");
+    exit(10);
+  }
+  return memory;
+}
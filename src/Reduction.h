@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Bitset.h"
+#include "DynamicArray.h"
+#include "Graph.h"
+
+#include <stddef.h>
+
+// Transitive reduction of graph edges: edge A->C is redundant when C depends on A also through other node, as in
+// A->B->C. Edges touching cycles are always kept.
+typedef struct Reduction {
+  Bitset redundant;  // per index in Graph.edges
+  size_t redundantSize;
+  size_t* rank;  // position in topological order
+  size_t* visited;
+  size_t* target;  // edge index increased by one, for dependencies of node being reduced
+  DynamicArray* stack;
+} Reduction;
+
+Reduction Reduction_Init();
+void Reduction_Destroy(Reduction* this);
+void Reduction_Build(Reduction* this, const Graph* graph);
@@ -0,0 +1,335 @@
+#include "Render.h"
+#include "Core.h"
+#include "Graph.h"
+#include "LogBook.h"
+#include "Profiler.h"
+#include "Workspace.h"
+
+#include <raygui.h>
+
+#include <math.h>
+#include <pthread.h>
+#include <raylib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define RENDER_MAX_TEXTURE_SIZE 4096
+#define RENDER_MAX_WORKERS 16
+
+typedef enum { EFrameState_Free, EFrameState_Replayed, EFrameState_LaidOut } EFrameState;
+
+typedef struct RenderFrame {
+  EFrameState state;
+  size_t entry;
+  Graph graph;
+  Workspace* workspace;
+  float zoom;    // fitting layout into RENDER_MAX_TEXTURE_SIZE
+  Vector2 size;  // of image, every frame is as large as its own layout
+} RenderFrame;
+
+typedef struct EncodeJob {
+  Image image;
+  char fileName[2100];
+} EncodeJob;
+
+// Pipeline: replay thread -> layout workers -> rendering (main) thread -> encoder threads.
+// Frame f lives in frames[f % framesInFlight] until it is drawn, so replay never runs too far ahead.
+typedef struct Renderer {
+  const RenderQuery* query;
+  const LogBook* logBook;
+  size_t framesSize;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t changed;
+  RenderFrame* frames;
+  size_t framesInFlight;
+  size_t replayed;
+  size_t nextLayout;
+  size_t rendered;
+
+  EncodeJob* jobs;
+  size_t jobsCapacity;
+  size_t jobsHead;
+  size_t jobsTail;
+  bool allQueued;
+} Renderer;
+
+static size_t Render_FrameEntry(const Renderer* this, size_t frame);
+static void Render_SizeFrame(RenderFrame* frame);
+static void Render_DrawFrame(Renderer* this, RenderFrame* frame, RenderTexture2D target);
+static void* Render_ReplayThread(void* arg);
+static void* Render_LayoutThread(void* arg);
+static void* Render_EncodeThread(void* arg);
+
+int Render_Run(const RenderQuery* query) {
+  if (query->sourcesSize == 0 || !query->outputDir) {
+    fprintf(stderr, "Rendering requires log file path and output directory\n");
+    return 2;
+  }
+  if (access(query->outputDir, W_OK)) {
+    perror(query->outputDir);
+    return 2;
+  }
+
+  LogBook logBook = LogBook_Init();
+  logBook.diagnostics.verbosity = query->verbosity;
+  if (!LogBook_LoadMerged(&logBook, query->sources, query->sourcesSize, NULL) || logBook.entriesSize == 0) {
+    fprintf(stderr, "No entries to render in %s\n", query->sources[0].fileName);
+    LogBook_Destroy(&logBook);
+    return 1;
+  }
+
+  size_t workers = query->workers;
+  if (workers == 0) {
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    workers = cpus > 2 ? (size_t)cpus / 2 : 1;
+  }
+  workers = workers > RENDER_MAX_WORKERS ? RENDER_MAX_WORKERS : workers;
+  const size_t every = query->every > 0 ? query->every : 1;
+
+  Renderer this = {
+      .query = query,
+      .logBook = &logBook,
+      .framesSize = (logBook.entriesSize - 1) / every + 1 + ((logBook.entriesSize - 1) % every != 0),
+      .framesInFlight = 2 * workers + 2,
+      .replayed = 0,
+      .nextLayout = 0,
+      .rendered = 0,
+      .jobsCapacity = 2 * workers,
+      .jobsHead = 0,
+      .jobsTail = 0,
+      .allQueued = false,
+  };
+  this.frames = calloc(this.framesInFlight, sizeof(RenderFrame));
+  this.jobs = calloc(this.jobsCapacity, sizeof(EncodeJob));
+  if (this.frames == NULL || this.jobs == NULL) {
+    perror("Cannot calloc memory for Renderer");
+    exit(10);
+  }
+  for (size_t i = 0; i < this.framesInFlight; ++i) {
+    this.frames[i].state = EFrameState_Free;
+    this.frames[i].graph = Graph_Init(NULL, 0);
+    this.frames[i].workspace = malloc(Workspace_SizeOf());
+    Workspace_Init(this.frames[i].workspace);
+  }
+  pthread_mutex_init(&this.mutex, NULL);
+  pthread_cond_init(&this.changed, NULL);
+
+  SetTraceLogLevel(LOG_WARNING);
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(64, 64, "DepView render");
+  Vector2 targetSize = {64, 64};  // grows to largest frame drawn so far, frames are cropped out of it
+  RenderTexture2D target = LoadRenderTexture(targetSize.x, targetSize.y);
+
+  pthread_t replayThread;
+  pthread_t layoutThreads[RENDER_MAX_WORKERS];
+  pthread_t encodeThreads[RENDER_MAX_WORKERS];
+  if (pthread_create(&replayThread, NULL, Render_ReplayThread, &this)) {
+    perror("Cannot start replay thread");
+    exit(10);
+  }
+  for (size_t i = 0; i < workers; ++i) {
+    if (pthread_create(&layoutThreads[i], NULL, Render_LayoutThread, &this) ||
+        pthread_create(&encodeThreads[i], NULL, Render_EncodeThread, &this)) {
+      perror("Cannot start render worker thread");
+      exit(10);
+    }
+  }
+
+  // OpenGL context belongs to this thread, so drawing and read back happen here
+  for (size_t f = 0; f < this.framesSize; ++f) {
+    RenderFrame* frame = &this.frames[f % this.framesInFlight];
+    pthread_mutex_lock(&this.mutex);
+    while (frame->state != EFrameState_LaidOut) {
+      pthread_cond_wait(&this.changed, &this.mutex);
+    }
+    pthread_mutex_unlock(&this.mutex);
+
+    Image image;
+    {
+      PROFILER_SCOPE(EPhase_Render);
+      if (frame->size.x > targetSize.x || frame->size.y > targetSize.y) {
+        UnloadRenderTexture(target);
+        targetSize = (Vector2){fmaxf(targetSize.x, frame->size.x), fmaxf(targetSize.y, frame->size.y)};
+        target = LoadRenderTexture(targetSize.x, targetSize.y);
+      }
+      Render_DrawFrame(&this, frame, target);
+      image = LoadImageFromTexture(target.texture);
+      ImageFlipVertical(&image);
+      ImageCrop(&image, (Rectangle){0, 0, frame->size.x, frame->size.y});
+    }
+
+    pthread_mutex_lock(&this.mutex);
+    while (this.jobsTail - this.jobsHead == this.jobsCapacity) {
+      pthread_cond_wait(&this.changed, &this.mutex);
+    }
+    EncodeJob* job = &this.jobs[this.jobsTail % this.jobsCapacity];
+    job->image = image;
+    snprintf(job->fileName, sizeof(job->fileName), "%s/frame_%06zu.png", query->outputDir, f);
+    ++this.jobsTail;
+    Graph_Destroy(&frame->graph);
+    frame->graph = Graph_Init(NULL, 0);
+    frame->state = EFrameState_Free;
+    ++this.rendered;
+    pthread_cond_broadcast(&this.changed);
+    pthread_mutex_unlock(&this.mutex);
+    PROFILER_COLLECT();
+  }
+
+  pthread_mutex_lock(&this.mutex);
+  this.allQueued = true;
+  pthread_cond_broadcast(&this.changed);
+  pthread_mutex_unlock(&this.mutex);
+  pthread_join(replayThread, NULL);
+  for (size_t i = 0; i < workers; ++i) {
+    pthread_join(layoutThreads[i], NULL);
+    pthread_join(encodeThreads[i], NULL);
+  }
+  if (query->verbosity >= EVerbosity_Errors) {
+    fprintf(stderr, "Rendered %zu frames of up to %.0fx%.0f to %s\n", this.framesSize, targetSize.x, targetSize.y,
+            query->outputDir);
+  }
+
+  UnloadRenderTexture(target);
+  CloseWindow();
+  for (size_t i = 0; i < this.framesInFlight; ++i) {
+    Graph_Destroy(&this.frames[i].graph);
+    Workspace_Destroy(this.frames[i].workspace);
+    free(this.frames[i].workspace);
+  }
+  free(this.frames);
+  free(this.jobs);
+  pthread_mutex_destroy(&this.mutex);
+  pthread_cond_destroy(&this.changed);
+  LogBook_Destroy(&logBook);
+  return 0;
+}
+
+static size_t Render_FrameEntry(const Renderer* this, size_t frame) {
+  const size_t entry = frame * (this->query->every > 0 ? this->query->every : 1);
+  return entry < this->logBook->entriesSize ? entry : this->logBook->entriesSize - 1;
+}
+
+// Any snapshot may have the largest layout, e.g. removed dependency can make earlier graph deeper than the last one,
+// so every frame is sized by its own layout
+static void Render_SizeFrame(RenderFrame* frame) {
+  const Rectangle minimal = {0, 0, 64, 64};
+  Workspace_SetZoom(frame->workspace, 1.0);
+  Vector2 size = Workspace_GetSpaceSize(frame->workspace, &minimal);
+  const float longer = fmaxf(size.x, size.y);
+  if (longer > RENDER_MAX_TEXTURE_SIZE) {
+    Workspace_SetZoom(frame->workspace, RENDER_MAX_TEXTURE_SIZE / longer);
+    size = Workspace_GetSpaceSize(frame->workspace, &minimal);
+  }
+  frame->zoom = Workspace_GetZoom(frame->workspace);
+  frame->size =
+      (Vector2){ceilf(fminf(size.x, RENDER_MAX_TEXTURE_SIZE)), ceilf(fminf(size.y, RENDER_MAX_TEXTURE_SIZE))};
+}
+
+static void Render_DrawFrame(Renderer* this, RenderFrame* frame, RenderTexture2D target) {
+  Core core = {
+      .selectedFileName = "",
+      .loading = false,
+      .cancelLoading = false,
+      .loadingProgress = 1.0,
+      .logBook = *this->logBook,
+      .currentLog = frame->entry,
+      .oldGraph = Graph_Init(NULL, 0),
+      .currentGraph = frame->graph,
+  };
+  const Rectangle view = {0, 0, frame->size.x, frame->size.y};
+  const Vector2 scrollOffset = {0, 0};
+
+  BeginTextureMode(target);
+  ClearBackground(GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+  Workspace_SetZoom(frame->workspace, frame->zoom);
+  Workspace_Draw(frame->workspace, &core, 1.0, &view, &scrollOffset);
+  char label[64];
+  snprintf(label, sizeof(label), "#%zu  %ld", frame->entry, (long)this->logBook->entries[frame->entry].timestamp);
+  DrawText(label, 4, view.height - 14, 10, GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_NORMAL)));
+  EndTextureMode();
+}
+
+// Replay is sequential by nature, snapshots are copied out for parallel layout
+static void* Render_ReplayThread(void* arg) {
+  Renderer* this = arg;
+  Graph graph = Graph_Make(this->logBook);
+  Graph_SetRetention(&graph, this->query->retention);
+  size_t entry = 0;
+  for (size_t f = 0; f < this->framesSize; ++f) {
+    const size_t frameEntry = Render_FrameEntry(this, f);
+    {
+      PROFILER_SCOPE(EPhase_GraphChange);
+      for (; entry <= frameEntry; ++entry) {
+        Graph_Apply(&graph, this->logBook, &this->logBook->entries[entry]);
+      }
+    }
+
+    RenderFrame* frame = &this->frames[f % this->framesInFlight];
+    pthread_mutex_lock(&this->mutex);
+    while (frame->state != EFrameState_Free || f - this->rendered >= this->framesInFlight) {
+      pthread_cond_wait(&this->changed, &this->mutex);
+    }
+    pthread_mutex_unlock(&this->mutex);
+
+    Graph_Copy(&frame->graph, &graph);
+    frame->entry = frameEntry;
+
+    pthread_mutex_lock(&this->mutex);
+    frame->state = EFrameState_Replayed;
+    ++this->replayed;
+    pthread_cond_broadcast(&this->changed);
+    pthread_mutex_unlock(&this->mutex);
+  }
+  Graph_Destroy(&graph);
+  return NULL;
+}
+
+static void* Render_LayoutThread(void* arg) {
+  Renderer* this = arg;
+  for (;;) {
+    pthread_mutex_lock(&this->mutex);
+    while (this->nextLayout == this->replayed && this->nextLayout < this->framesSize) {
+      pthread_cond_wait(&this->changed, &this->mutex);
+    }
+    if (this->nextLayout == this->framesSize) {
+      pthread_mutex_unlock(&this->mutex);
+      return NULL;
+    }
+    RenderFrame* frame = &this->frames[this->nextLayout++ % this->framesInFlight];
+    pthread_mutex_unlock(&this->mutex);
+
+    Workspace_BuildLayout(frame->workspace, &frame->graph);
+    Render_SizeFrame(frame);
+
+    pthread_mutex_lock(&this->mutex);
+    frame->state = EFrameState_LaidOut;
+    pthread_cond_broadcast(&this->changed);
+    pthread_mutex_unlock(&this->mutex);
+  }
+}
+
+static void* Render_EncodeThread(void* arg) {
+  Renderer* this = arg;
+  for (;;) {
+    pthread_mutex_lock(&this->mutex);
+    while (this->jobsHead == this->jobsTail && !this->allQueued) {
+      pthread_cond_wait(&this->changed, &this->mutex);
+    }
+    if (this->jobsHead == this->jobsTail) {
+      pthread_mutex_unlock(&this->mutex);
+      return NULL;
+    }
+    const EncodeJob job = this->jobs[this->jobsHead++ % this->jobsCapacity];
+    pthread_cond_broadcast(&this->changed);
+    pthread_mutex_unlock(&this->mutex);
+
+    PROFILER_SCOPE(EPhase_Encode);
+    if (!ExportImage(job.image, job.fileName)) {
+      fprintf(stderr, "Cannot write %s\n", job.fileName);
+    }
+    UnloadImage(job.image);
+  }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Diagnostics.h"
+#include "Graph.h"
+
+#include <stddef.h>
+
+typedef struct RenderQuery {
+  const LogSource* sources;  // logs merged into one
+  size_t sourcesSize;
+  const char* outputDir;
+  size_t every;         // render every N-th entry, last entry is always rendered
+  size_t workers;       // threads for layout and for PNG encoding each, 0 picks from CPU count
+  Retention retention;  // finished nodes kept in graph
+  EVerbosity verbosity;
+} RenderQuery;
+
+// Renders snapshots of log to PNG sequence in hidden window. Returns process exit code.
+int Render_Run(const RenderQuery* query);
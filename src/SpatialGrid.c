@@ -0,0 +1,287 @@
+#include "SpatialGrid.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t SpatialGrid_Clamp(float value, size_t limit);
+static void SpatialGrid_BuildLevels(SpatialGrid* this, const Node* nodes);
+static size_t SpatialGrid_EdgeLevel(const SpatialGrid* this, Rectangle bounds);
+
+SpatialGrid SpatialGrid_Init() {
+  return (SpatialGrid){
+      .origin = {0, 0},
+      .cellSize = {1, 1},
+      .columns = 0,
+      .rows = 0,
+      .cellStarts = NULL,
+      .cellNodes = NULL,
+      .levelsSize = 0,
+  };
+}
+
+void SpatialGrid_Destroy(SpatialGrid* this) {
+  free(this->cellStarts);
+  this->cellStarts = NULL;
+  free(this->cellNodes);
+  this->cellNodes = NULL;
+  for (size_t i = 0; i < this->levelsSize; ++i) {
+    free(this->levels[i].counts);
+    this->levels[i].counts = NULL;
+    free(this->levels[i].edgeStarts);
+    this->levels[i].edgeStarts = NULL;
+    free(this->levels[i].edges);
+    this->levels[i].edges = NULL;
+  }
+  this->levelsSize = 0;
+  this->columns = 0;
+  this->rows = 0;
+}
+
+void SpatialGrid_Build(SpatialGrid* this,
+                       const Vector2* coordinates,
+                       const Node* nodes,
+                       size_t nodesSize,
+                       const Bitset* mask,
+                       Vector2 origin,
+                       Vector2 cellSize) {
+  SpatialGrid_Destroy(this);
+  this->origin = origin;
+  this->cellSize = cellSize;
+  this->columns = 1;
+  this->rows = 1;
+
+  for (size_t i = 0; i < nodesSize; ++i) {
+    if (mask && !Bitset_Test(mask, i)) {
+      continue;
+    }
+    size_t column = SpatialGrid_Clamp((coordinates[i].x - origin.x) / cellSize.x, (size_t)-1);
+    size_t row = SpatialGrid_Clamp((coordinates[i].y - origin.y) / cellSize.y, (size_t)-1);
+    this->columns = column + 1 > this->columns ? column + 1 : this->columns;
+    this->rows = row + 1 > this->rows ? row + 1 : this->rows;
+  }
+
+  // counting sort of nodes into cells
+  const size_t cellsSize = this->columns * this->rows;
+  this->cellStarts = calloc(cellsSize + 1, sizeof(size_t));
+  this->cellNodes = calloc(nodesSize ? nodesSize : 1, sizeof(size_t));
+  size_t* cellOfNode = calloc(nodesSize ? nodesSize : 1, sizeof(size_t));
+  if (this->cellStarts == NULL || this->cellNodes == NULL || cellOfNode == NULL) {
+    perror("Cannot calloc memory for SpatialGrid");
+    exit(10);
+  }
+  for (size_t i = 0; i < nodesSize; ++i) {
+    if (mask && !Bitset_Test(mask, i)) {
+      continue;
+    }
+    size_t column = SpatialGrid_Clamp((coordinates[i].x - origin.x) / cellSize.x, this->columns);
+    size_t row = SpatialGrid_Clamp((coordinates[i].y - origin.y) / cellSize.y, this->rows);
+    cellOfNode[i] = row * this->columns + column;
+    ++this->cellStarts[cellOfNode[i] + 1];
+  }
+  for (size_t i = 0; i < cellsSize; ++i) {
+    this->cellStarts[i + 1] += this->cellStarts[i];
+  }
+  size_t* cursor = calloc(cellsSize, sizeof(size_t));
+  if (cursor == NULL) {
+    perror("Cannot calloc memory for SpatialGrid");
+    exit(10);
+  }
+  memcpy(cursor, this->cellStarts, cellsSize * sizeof(size_t));
+  for (size_t i = 0; i < nodesSize; ++i) {
+    if (mask && !Bitset_Test(mask, i)) {
+      continue;
+    }
+    this->cellNodes[cursor[cellOfNode[i]]++] = i;
+  }
+  free(cursor);
+  free(cellOfNode);
+
+  SpatialGrid_BuildLevels(this, nodes);
+}
+
+// Edge is kept by the finest level at which its bounds span at most 2x2 tiles, in tile of their top left corner, so
+// every edge is stored once whatever its length. Bounds may stick out of grid by less than a tile, as bounds of edges
+// between its nodes do.
+void SpatialGrid_BuildEdges(SpatialGrid* this, const Rectangle* bounds, size_t edgesSize, const Bitset* mask) {
+  size_t* levelOfEdge = calloc(edgesSize ? edgesSize : 1, sizeof(size_t));
+  size_t* tileOfEdge = calloc(edgesSize ? edgesSize : 1, sizeof(size_t));
+  if (levelOfEdge == NULL || tileOfEdge == NULL) {
+    perror("Cannot calloc memory for SpatialGrid edges");
+    exit(10);
+  }
+  for (size_t level = 0; level < this->levelsSize; ++level) {
+    DensityTiles* tiles = &this->levels[level];
+    free(tiles->edgeStarts);
+    free(tiles->edges);
+    tiles->edgeStarts = calloc(tiles->columns * tiles->rows + 1, sizeof(size_t));
+    tiles->edges = NULL;
+    if (tiles->edgeStarts == NULL) {
+      perror("Cannot calloc memory for SpatialGrid edges");
+      exit(10);
+    }
+  }
+  for (size_t i = 0; i < edgesSize; ++i) {
+    if (mask && !Bitset_Test(mask, i)) {
+      continue;
+    }
+    const size_t level = SpatialGrid_EdgeLevel(this, bounds[i]);
+    const DensityTiles* tiles = &this->levels[level];
+    const GridRange range = SpatialGrid_Range(this, level, bounds[i]);
+    const size_t column = range.column0 < tiles->columns ? range.column0 : tiles->columns - 1;
+    const size_t row = range.row0 < tiles->rows ? range.row0 : tiles->rows - 1;
+    levelOfEdge[i] = level;
+    tileOfEdge[i] = row * tiles->columns + column;
+    ++tiles->edgeStarts[tileOfEdge[i] + 1];
+  }
+
+  // counting sort of edges into tiles of every level
+  size_t* cursors[SPATIALGRID_MAX_LEVELS];
+  for (size_t level = 0; level < this->levelsSize; ++level) {
+    DensityTiles* tiles = &this->levels[level];
+    const size_t tilesSize = tiles->columns * tiles->rows;
+    for (size_t tile = 0; tile < tilesSize; ++tile) {
+      tiles->edgeStarts[tile + 1] += tiles->edgeStarts[tile];
+    }
+    tiles->edges = calloc(tiles->edgeStarts[tilesSize] ? tiles->edgeStarts[tilesSize] : 1, sizeof(size_t));
+    cursors[level] = calloc(tilesSize, sizeof(size_t));
+    if (tiles->edges == NULL || cursors[level] == NULL) {
+      perror("Cannot calloc memory for SpatialGrid edges");
+      exit(10);
+    }
+    memcpy(cursors[level], tiles->edgeStarts, tilesSize * sizeof(size_t));
+  }
+  for (size_t i = 0; i < edgesSize; ++i) {
+    if (mask && !Bitset_Test(mask, i)) {
+      continue;
+    }
+    this->levels[levelOfEdge[i]].edges[cursors[levelOfEdge[i]][tileOfEdge[i]]++] = i;
+  }
+  for (size_t level = 0; level < this->levelsSize; ++level) {
+    free(cursors[level]);
+  }
+  free(tileOfEdge);
+  free(levelOfEdge);
+}
+
+Vector2 SpatialGrid_TileSize(const SpatialGrid* this, size_t level) {
+  const float scale = (float)((size_t)1 << level);
+  return (Vector2){this->cellSize.x * scale, this->cellSize.y * scale};
+}
+
+GridRange SpatialGrid_Range(const SpatialGrid* this, size_t level, Rectangle area) {
+  GridRange range = {0, 0, 0, 0};
+  if (level >= this->levelsSize) {
+    return range;
+  }
+  const DensityTiles* tiles = &this->levels[level];
+  const Vector2 tileSize = SpatialGrid_TileSize(this, level);
+  range.column0 = SpatialGrid_Clamp((area.x - this->origin.x) / tileSize.x, tiles->columns);
+  range.column1 = SpatialGrid_Clamp((area.x + area.width - this->origin.x) / tileSize.x + 1, tiles->columns);
+  range.row0 = SpatialGrid_Clamp((area.y - this->origin.y) / tileSize.y, tiles->rows);
+  range.row1 = SpatialGrid_Clamp((area.y + area.height - this->origin.y) / tileSize.y + 1, tiles->rows);
+  return range;
+}
+
+const size_t* SpatialGrid_CellBegin(const SpatialGrid* this, size_t column, size_t row) {
+  return this->cellNodes + this->cellStarts[row * this->columns + column];
+}
+
+const size_t* SpatialGrid_CellEnd(const SpatialGrid* this, size_t column, size_t row) {
+  return this->cellNodes + this->cellStarts[row * this->columns + column + 1];
+}
+
+const unsigned int* SpatialGrid_Tile(const SpatialGrid* this, size_t level, size_t column, size_t row) {
+  const DensityTiles* tiles = &this->levels[level];
+  return tiles->counts + (row * tiles->columns + column) * SPATIALGRID_STATUSES;
+}
+
+// Tiles of level which may hold edges crossing area: edge starting one tile up or left of it may reach into it, and
+// so may edge sticking out of grid when area is next to it
+GridRange SpatialGrid_EdgeRange(const SpatialGrid* this, size_t level, Rectangle area) {
+  const Vector2 tileSize = SpatialGrid_TileSize(this, level);
+  area.x -= tileSize.x;
+  area.y -= tileSize.y;
+  area.width += 2 * tileSize.x;
+  area.height += 2 * tileSize.y;
+  return SpatialGrid_Range(this, level, area);
+}
+
+const size_t* SpatialGrid_EdgesBegin(const SpatialGrid* this, size_t level, size_t column, size_t row) {
+  const DensityTiles* tiles = &this->levels[level];
+  return tiles->edges + tiles->edgeStarts[row * tiles->columns + column];
+}
+
+const size_t* SpatialGrid_EdgesEnd(const SpatialGrid* this, size_t level, size_t column, size_t row) {
+  const DensityTiles* tiles = &this->levels[level];
+  return tiles->edges + tiles->edgeStarts[row * tiles->columns + column + 1];
+}
+
+static size_t SpatialGrid_Clamp(float value, size_t limit) {
+  if (!(value > 0)) {
+    return 0;
+  }
+  if (value >= (float)limit) {
+    return limit;
+  }
+  return (size_t)floorf(value);
+}
+
+// Edges too long for every level are kept by the coarsest one, whose single tile covers whole grid
+static size_t SpatialGrid_EdgeLevel(const SpatialGrid* this, Rectangle bounds) {
+  for (size_t level = 0; level + 1 < this->levelsSize; ++level) {
+    const Vector2 tileSize = SpatialGrid_TileSize(this, level);
+    const float column0 = floorf((bounds.x - this->origin.x) / tileSize.x);
+    const float column1 = floorf((bounds.x + bounds.width - this->origin.x) / tileSize.x);
+    const float row0 = floorf((bounds.y - this->origin.y) / tileSize.y);
+    const float row1 = floorf((bounds.y + bounds.height - this->origin.y) / tileSize.y);
+    if (column1 - column0 <= 1 && row1 - row0 <= 1) {
+      return level;
+    }
+  }
+  return this->levelsSize - 1;
+}
+
+static void SpatialGrid_BuildLevels(SpatialGrid* this, const Node* nodes) {
+  DensityTiles* base = &this->levels[0];
+  base->columns = this->columns;
+  base->rows = this->rows;
+  base->counts = calloc(base->columns * base->rows * SPATIALGRID_STATUSES, sizeof(unsigned int));
+  if (base->counts == NULL) {
+    perror("Cannot calloc memory for SpatialGrid tiles");
+    exit(10);
+  }
+  for (size_t cell = 0; cell < this->columns * this->rows; ++cell) {
+    for (size_t j = this->cellStarts[cell]; j < this->cellStarts[cell + 1]; ++j) {
+      ++base->counts[cell * SPATIALGRID_STATUSES + nodes[this->cellNodes[j]].status];
+    }
+  }
+  this->levelsSize = 1;
+
+  // every next level merges 2x2 tiles of the previous one
+  while (this->levelsSize < SPATIALGRID_MAX_LEVELS) {
+    const DensityTiles* prev = &this->levels[this->levelsSize - 1];
+    if (prev->columns == 1 && prev->rows == 1) {
+      break;
+    }
+    DensityTiles* next = &this->levels[this->levelsSize];
+    next->columns = (prev->columns + 1) / 2;
+    next->rows = (prev->rows + 1) / 2;
+    next->counts = calloc(next->columns * next->rows * SPATIALGRID_STATUSES, sizeof(unsigned int));
+    if (next->counts == NULL) {
+      perror("Cannot calloc memory for SpatialGrid tiles");
+      exit(10);
+    }
+    for (size_t row = 0; row < prev->rows; ++row) {
+      for (size_t column = 0; column < prev->columns; ++column) {
+        const unsigned int* from = prev->counts + (row * prev->columns + column) * SPATIALGRID_STATUSES;
+        unsigned int* to = next->counts + ((row / 2) * next->columns + column / 2) * SPATIALGRID_STATUSES;
+        for (size_t s = 0; s < SPATIALGRID_STATUSES; ++s) {
+          to[s] += from[s];
+        }
+      }
+    }
+    ++this->levelsSize;
+  }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Bitset.h"
+#include "Graph.h"
+
+#include <raylib.h>
+#include <stddef.h>
+
+#define SPATIALGRID_MAX_LEVELS 24
+#define SPATIALGRID_STATUSES 3
+
+typedef struct GridRange {
+  size_t column0;
+  size_t column1;
+  size_t row0;
+  size_t row1;
+} GridRange;
+
+typedef struct DensityTiles {
+  size_t columns;
+  size_t rows;
+  unsigned int* counts;  // SPATIALGRID_STATUSES counters per tile
+  size_t* edgeStarts;    // columns * rows + 1 offsets into edges
+  size_t* edges;         // kept by this level, by tile of top left corner of their bounds
+} DensityTiles;
+
+typedef struct SpatialGrid {
+  Vector2 origin;
+  Vector2 cellSize;
+  size_t columns;
+  size_t rows;
+  size_t* cellStarts;  // columns * rows + 1 offsets into cellNodes
+  size_t* cellNodes;
+  size_t levelsSize;
+  DensityTiles levels[SPATIALGRID_MAX_LEVELS];
+} SpatialGrid;
+
+SpatialGrid SpatialGrid_Init();
+void SpatialGrid_Destroy(SpatialGrid* this);
+void SpatialGrid_Build(SpatialGrid* this,
+                       const Vector2* coordinates,
+                       const Node* nodes,
+                       size_t nodesSize,
+                       const Bitset* mask,  // nodes to be placed in grid, NULL means all
+                       Vector2 origin,
+                       Vector2 cellSize);
+void SpatialGrid_BuildEdges(SpatialGrid* this,
+                            const Rectangle* bounds,
+                            size_t edgesSize,
+                            const Bitset* mask);  // edges to be placed in grid, NULL means all
+
+Vector2 SpatialGrid_TileSize(const SpatialGrid* this, size_t level);
+GridRange SpatialGrid_Range(const SpatialGrid* this, size_t level, Rectangle area);
+const size_t* SpatialGrid_CellBegin(const SpatialGrid* this, size_t column, size_t row);
+const size_t* SpatialGrid_CellEnd(const SpatialGrid* this, size_t column, size_t row);
+const unsigned int* SpatialGrid_Tile(const SpatialGrid* this, size_t level, size_t column, size_t row);
+GridRange SpatialGrid_EdgeRange(const SpatialGrid* this, size_t level, Rectangle area);
+const size_t* SpatialGrid_EdgesBegin(const SpatialGrid* this, size_t level, size_t column, size_t row);
+const size_t* SpatialGrid_EdgesEnd(const SpatialGrid* this, size_t level, size_t column, size_t row);
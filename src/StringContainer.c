@@ -51,7 +51,6 @@ size_t StringContainer_Append(StringContainer* this, char* newString) {
     this->end = this->begin + used;
     memset(this->end, '\0', StringContainer_Available(this));
   }
-  printf("Added %s name\n", newString);
   strcpy(this->end, newString);
   size_t used = StringContainer_Used(this);
   DynamicArray_Push(this->offsets, used);
@@ -0,0 +1,230 @@
+#include "Timeline.h"
+#include "Profiler.h"
+#include "Workspace.h"
+
+#include <raygui.h>
+
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+#define TIMELINE_ROW_H 14
+#define TIMELINE_NAME_W 140
+#define TIMELINE_HEADER_H 16
+#define TIMELINE_MAX_PIXELS_PER_SECOND 64
+#define TIMELINE_TICK_MIN_W 90
+
+// Screen x of time, as scrolled and zoomed in current frame
+typedef struct TimeAxis {
+  time_t begin;
+  double origin;  // x of begin
+  double pixelsPerSecond;
+  float left;     // visible part of bars
+  float right;
+} TimeAxis;
+
+static bool Timeline_HandleZoom(Timeline* this, const Rectangle rect, float barsWidth, float maxZoom);
+static void Timeline_DrawRow(const NodeStats* stats, size_t node, const TimeAxis* axis, float y);
+static void Timeline_DrawTicks(const TimeAxis* axis, float y);
+static const NodeChange* Timeline_ChangeAt(const NodeChange* first, const NodeChange* last, double time);
+static float Timeline_X(const TimeAxis* axis, double time);
+static double Timeline_Time(const TimeAxis* axis, float x);
+
+Timeline Timeline_Init() {
+  return (Timeline){
+      .scrollOffset = {0, 0},
+      .visibleRect = {0, 0, 0, 0},
+      .zoom = 1,
+  };
+}
+
+// Row of node is moved to the middle of view
+void Timeline_ScrollToNode(Timeline* this, size_t node) {
+  const float rowsHeight = this->visibleRect.height - TIMELINE_HEADER_H;
+  this->scrollOffset.y = fminf(0, rowsHeight / 2 - TIMELINE_ROW_H * (node + 0.5));
+}
+
+// Returns entry of clicked time, (size_t)-1 if none. Clicked node name is put into clickedNode.
+size_t Timeline_Draw(Timeline* this,
+                     const Rectangle rect,
+                     const LogBook* logBook,
+                     size_t currentLog,
+                     size_t selectedNode,
+                     size_t* clickedNode) {
+  PROFILER_SCOPE(EPhase_DrawTimeline);
+  const NodeStats* stats = &logBook->stats;
+  const time_t span = stats->end > stats->begin ? stats->end - stats->begin : 1;
+  const float barsWidth = rect.width - TIMELINE_NAME_W - 15;
+  const float maxZoom = fmaxf(1, TIMELINE_MAX_PIXELS_PER_SECOND * span / barsWidth);
+  this->zoom = fminf(this->zoom, maxZoom);  // panel may have shrunk
+
+  if (Timeline_HandleZoom(this, rect, barsWidth, maxZoom)) {
+    GuiLock();  // mouse wheel has been consumed by zoom, scroll panel shall not scroll with it
+  }
+  GuiScrollPanel(rect, NULL,
+                 (Rectangle){.x = 0,
+                             .y = 0,
+                             .width = TIMELINE_NAME_W + barsWidth * this->zoom,
+                             .height = TIMELINE_HEADER_H + stats->nodesSize * TIMELINE_ROW_H},
+                 &this->scrollOffset, &this->visibleRect);
+  GuiUnlock();
+
+  const Rectangle view = this->visibleRect;
+  const TimeAxis axis = {
+      .begin = stats->begin,
+      .origin = view.x + TIMELINE_NAME_W + this->scrollOffset.x,
+      .pixelsPerSecond = barsWidth * this->zoom / span,
+      .left = view.x + TIMELINE_NAME_W,
+      .right = view.x + view.width,
+  };
+  const Rectangle bars = {axis.left, view.y + TIMELINE_HEADER_H, axis.right - axis.left,
+                          view.height - TIMELINE_HEADER_H};
+  const Rectangle names = {view.x, bars.y, TIMELINE_NAME_W, bars.height};
+  if (bars.width <= 0 || bars.height <= 0 || stats->nodesSize == 0) {
+    return (size_t)-1;
+  }
+
+  // only rows intersecting view are drawn, and in every row only changes of visible time range
+  const float rowsY = bars.y + this->scrollOffset.y;
+  const float firstRow = -this->scrollOffset.y / TIMELINE_ROW_H;
+  size_t first = firstRow > 0 ? (size_t)firstRow : 0;
+  size_t last = (size_t)((-this->scrollOffset.y + bars.height) / TIMELINE_ROW_H) + 1;
+  last = last > stats->nodesSize ? stats->nodesSize : last;
+
+  BeginScissorMode(bars.x, bars.y, bars.width, bars.height);
+  if (selectedNode >= first && selectedNode < last) {
+    DrawRectangleRec((Rectangle){bars.x, rowsY + selectedNode * TIMELINE_ROW_H, bars.width, TIMELINE_ROW_H},
+                     Fade(GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_PRESSED)), 0.25));
+  }
+  for (size_t i = first; i < last; ++i) {
+    Timeline_DrawRow(stats, i, &axis, rowsY + i * TIMELINE_ROW_H);
+  }
+  if (currentLog < logBook->entriesSize) {
+    const float x = Timeline_X(&axis, logBook->entries[currentLog].timestamp);
+    DrawLine(x, bars.y, x, bars.y + bars.height, GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_PRESSED)));
+  }
+  EndScissorMode();
+
+  BeginScissorMode(names.x, names.y, names.width, names.height);
+  DrawRectangleRec(names, GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+  for (size_t i = first; i < last; ++i) {
+    if (i == selectedNode) {
+      GuiSetState(STATE_PRESSED);
+    }
+    if (GuiLabelButton((Rectangle){names.x + 4, rowsY + i * TIMELINE_ROW_H, names.width - 4, TIMELINE_ROW_H},
+                       LogBook_GetNodeName(logBook, stats->nodeNames[i]))) {
+      *clickedNode = i;
+    }
+    if (i == selectedNode) {
+      GuiSetState(STATE_NORMAL);
+    }
+  }
+  EndScissorMode();
+
+  BeginScissorMode(bars.x, view.y, bars.width, TIMELINE_HEADER_H);
+  DrawRectangleRec((Rectangle){bars.x, view.y, bars.width, TIMELINE_HEADER_H},
+                   GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+  Timeline_DrawTicks(&axis, view.y);
+  EndScissorMode();
+
+  const Vector2 mouse = GetMousePosition();
+  const Rectangle clickable = {bars.x, view.y, bars.width, view.height};
+  if (!GuiIsLocked() && GuiGetState() != STATE_DISABLED && IsMouseButtonPressed(MOUSE_BUTTON_LEFT) &&
+      CheckCollisionPointRec(mouse, clickable)) {
+    const size_t entry = LogBook_FindEntry(logBook, floor(Timeline_Time(&axis, mouse.x)));
+    return entry == (size_t)-1 ? 0 : entry;
+  }
+  return (size_t)-1;
+}
+
+// Zooms time only, keeping time under cursor in place
+static bool Timeline_HandleZoom(Timeline* this, const Rectangle rect, float barsWidth, float maxZoom) {
+  const Vector2 mouse = GetMousePosition();
+  if (GuiGetState() == STATE_DISABLED || !CheckCollisionPointRec(mouse, rect) ||
+      !(IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL))) {
+    return false;
+  }
+  const float wheel = GetMouseWheelMove();
+  if (wheel == 0 || barsWidth <= 0) {
+    return false;
+  }
+  const float oldZoom = this->zoom;
+  this->zoom = fminf(fmaxf(oldZoom * powf(1.25, wheel), 1), maxZoom);
+  const float anchor = mouse.x - this->visibleRect.x - TIMELINE_NAME_W;
+  this->scrollOffset.x = anchor - (anchor - this->scrollOffset.x) * this->zoom / oldZoom;
+  return true;
+}
+
+static void Timeline_DrawRow(const NodeStats* stats, size_t node, const TimeAxis* axis, float y) {
+  const NodeChange* first = stats->changes + stats->changeStarts[node];
+  const NodeChange* last = stats->changes + stats->changeStarts[node + 1];
+  const time_t end = stats->removed[node] ? stats->removed[node] : stats->end;
+  const double from = Timeline_Time(axis, axis->left);
+  const double until = Timeline_Time(axis, axis->right);
+  if (first == last || first->timestamp > until || end < from) {
+    return;
+  }
+
+  const NodeChange* it = Timeline_ChangeAt(first, last, from);
+  while (it < last) {
+    const time_t segmentEnd = it + 1 < last ? it[1].timestamp : end;
+    const float x0 = fmaxf(Timeline_X(axis, it->timestamp), axis->left - 1);
+    const float x1 = fminf(Timeline_X(axis, segmentEnd), axis->right + 1);
+    const float width = x1 - x0 > 1 ? x1 - x0 : 1;
+    DrawRectangleRec((Rectangle){x0, y + 2, width, TIMELINE_ROW_H - 4}, Workspace_StatusColor(it->status, false));
+    if (segmentEnd >= until) {
+      break;
+    }
+    // changes covered by pixel just drawn are skipped, so zoomed out row costs no more than its width
+    const NodeChange* next = Timeline_ChangeAt(it + 1, last, Timeline_Time(axis, x0 + width + 1));
+    it = next > it + 1 ? next : it + 1;
+  }
+}
+
+// Ticks fall on round times, at least TIMELINE_TICK_MIN_W apart
+static void Timeline_DrawTicks(const TimeAxis* axis, float y) {
+  static const time_t STEPS[] = {1,    2,    5,    10,    15,    30,    60,    120,   300,    600,
+                                 900,  1800, 3600, 7200,  10800, 21600, 43200, 86400, 172800, 604800};
+  const size_t STEPS_SIZE = sizeof(STEPS) / sizeof(STEPS[0]);
+  size_t s = 0;
+  while (s + 1 < STEPS_SIZE && STEPS[s] * axis->pixelsPerSecond < TIMELINE_TICK_MIN_W) {
+    ++s;
+  }
+  const time_t step = STEPS[s];
+  const time_t from = (time_t)floor(Timeline_Time(axis, axis->left) / step) * step;
+  const double until = Timeline_Time(axis, axis->right);
+  const Color color = GetColor(GuiGetStyle(DEFAULT, LINE_COLOR));
+  for (time_t t = from; t <= until; t += step) {
+    const float x = Timeline_X(axis, t);
+    DrawLine(x, y + TIMELINE_HEADER_H - 4, x, y + TIMELINE_HEADER_H, color);
+    char label[16];
+    struct tm timeInfo;
+    gmtime_r(&t, &timeInfo);
+    strftime(label, sizeof(label), step < 60 ? "%H:%M:%S" : step < 86400 ? "%H:%M" : "%d-%m", &timeInfo);
+    GuiLabel((Rectangle){x + 2, y, TIMELINE_TICK_MIN_W - 4, TIMELINE_HEADER_H - 2}, label);
+  }
+}
+
+// Last change not later than time, first one when all are later
+static const NodeChange* Timeline_ChangeAt(const NodeChange* first, const NodeChange* last, double time) {
+  const NodeChange* low = first;
+  const NodeChange* high = last;
+  while (low < high) {
+    const NodeChange* middle = low + (high - low) / 2;
+    if (middle->timestamp <= time) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low > first ? low - 1 : first;
+}
+
+static float Timeline_X(const TimeAxis* axis, double time) {
+  return axis->origin + (time - axis->begin) * axis->pixelsPerSecond;
+}
+
+static double Timeline_Time(const TimeAxis* axis, float x) {
+  return axis->begin + (x - axis->origin) / axis->pixelsPerSecond;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "LogBook.h"
+
+#include <raylib.h>
+
+// Lifetimes of nodes as horizontal bars coloured by status, one row per node of NodeStats in order of addition
+typedef struct Timeline {
+  Vector2 scrollOffset;
+  Rectangle visibleRect;
+  float zoom;  // 1 fits whole log into panel width
+} Timeline;
+
+Timeline Timeline_Init();
+void Timeline_ScrollToNode(Timeline* this, size_t node);
+size_t Timeline_Draw(Timeline* this,
+                     const Rectangle rect,
+                     const LogBook* logBook,
+                     size_t currentLog,
+                     size_t selectedNode,
+                     size_t* clickedNode);
@@ -0,0 +1,184 @@
+#include "Trace.h"
+#include "Profiler.h"
+
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TRACE_BUFFER_SIZE (64 * 1024)
+#define TRACE_FLUSH_SIZE (48 * 1024)
+#define TRACE_EVENT_MAX_SIZE 256
+#define TRACE_NAMED_THREADS 64
+
+typedef struct TraceBuffer {
+  char* data;
+  size_t size;
+  size_t capacity;
+} TraceBuffer;
+
+// Main thread formats events into active buffer, writer thread saves pending one.
+// Buffers are swapped only when writer is idle, otherwise active buffer keeps growing.
+typedef struct Trace {
+  bool open;
+  FILE* file;
+  pthread_t writer;
+  pthread_mutex_t mutex;
+  pthread_cond_t wakeUp;
+  TraceBuffer active;
+  TraceBuffer pending;
+  bool pendingReady;
+  bool closing;
+  bool namedThreads[TRACE_NAMED_THREADS];
+} Trace;
+
+static Trace trace = {.open = false};
+
+static void Trace_Append(const ProfilerEvent* event);
+static void Trace_Printf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+static void Trace_NameThread(unsigned int thread);
+static void Trace_Handover();
+static void* Trace_WriterThread(void* arg);
+
+bool Trace_Open(const char* fileName) {
+  if (trace.open) {
+    return false;
+  }
+  FILE* file = fopen(fileName, "w");
+  if (file == NULL) {
+    perror("Cannot open trace file");
+    return false;
+  }
+  trace = (Trace){
+      .open = true,
+      .file = file,
+      .active = {.data = malloc(TRACE_BUFFER_SIZE), .size = 0, .capacity = TRACE_BUFFER_SIZE},
+      .pending = {.data = malloc(TRACE_BUFFER_SIZE), .size = 0, .capacity = TRACE_BUFFER_SIZE},
+      .pendingReady = false,
+      .closing = false,
+  };
+  if (trace.active.data == NULL || trace.pending.data == NULL) {
+    perror("Cannot malloc memory for Trace");
+    exit(10);
+  }
+  pthread_mutex_init(&trace.mutex, NULL);
+  pthread_cond_init(&trace.wakeUp, NULL);
+  if (pthread_create(&trace.writer, NULL, Trace_WriterThread, NULL) != 0) {
+    perror("Cannot start trace writer thread");
+    exit(10);
+  }
+
+  Trace_Printf("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  Trace_Printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"DepView\"}}");
+  Profiler_SetSink(Trace_Append);
+  return true;
+}
+
+void Trace_Close() {
+  if (!trace.open) {
+    return;
+  }
+  Profiler_Collect();
+  Profiler_SetSink(NULL);
+
+  pthread_mutex_lock(&trace.mutex);
+  trace.closing = true;
+  pthread_cond_signal(&trace.wakeUp);
+  pthread_mutex_unlock(&trace.mutex);
+  pthread_join(trace.writer, NULL);
+
+  Trace_Printf("\n]}\n");
+  fwrite(trace.active.data, 1, trace.active.size, trace.file);
+  fclose(trace.file);
+  free(trace.active.data);
+  free(trace.pending.data);
+  pthread_mutex_destroy(&trace.mutex);
+  pthread_cond_destroy(&trace.wakeUp);
+  trace = (Trace){.open = false};
+}
+
+bool Trace_IsOpen() {
+  return trace.open;
+}
+
+static void Trace_Append(const ProfilerEvent* event) {
+  Trace_NameThread(event->thread);
+  const uint64_t origin = Profiler_GetOrigin();
+  const double begin = event->begin > origin ? (event->begin - origin) / 1e3 : 0;
+  Trace_Printf(",\n{\"name\":\"%s\",\"cat\":\"depview\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+               Profiler_PhaseName(event->phase), event->thread, begin, (event->end - event->begin) / 1e3);
+  if (trace.active.size >= TRACE_FLUSH_SIZE) {
+    Trace_Handover();
+  }
+}
+
+static void Trace_Printf(const char* format, ...) {
+  TraceBuffer* buffer = &trace.active;
+  if (buffer->capacity - buffer->size < TRACE_EVENT_MAX_SIZE) {
+    buffer->capacity *= 2;
+    buffer->data = realloc(buffer->data, buffer->capacity);
+    if (buffer->data == NULL) {
+      perror("Cannot realloc memory for Trace");
+      exit(10);
+    }
+  }
+  va_list args;
+  va_start(args, format);
+  const size_t available = buffer->capacity - buffer->size;
+  const int written = vsnprintf(buffer->data + buffer->size, available, format, args);
+  va_end(args);
+  if (written > 0 && (size_t)written < available) {
+    buffer->size += written;
+  }
+}
+
+static void Trace_NameThread(unsigned int thread) {
+  if (thread >= TRACE_NAMED_THREADS || trace.namedThreads[thread]) {
+    return;
+  }
+  trace.namedThreads[thread] = true;
+  if (thread == 0) {
+    Trace_Printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}}");
+  } else {
+    Trace_Printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"worker %u\"}}",
+                 thread, thread);
+  }
+}
+
+// Never blocks on file I/O: if writer is still busy, events stay in active buffer until next try
+static void Trace_Handover() {
+  if (pthread_mutex_trylock(&trace.mutex) != 0) {
+    return;
+  }
+  if (!trace.pendingReady) {
+    const TraceBuffer written = trace.pending;
+    trace.pending = trace.active;
+    trace.active = written;
+    trace.active.size = 0;
+    trace.pendingReady = true;
+    pthread_cond_signal(&trace.wakeUp);
+  }
+  pthread_mutex_unlock(&trace.mutex);
+}
+
+static void* Trace_WriterThread(void* arg) {
+  (void)arg;
+  pthread_mutex_lock(&trace.mutex);
+  for (;;) {
+    while (!trace.pendingReady && !trace.closing) {
+      pthread_cond_wait(&trace.wakeUp, &trace.mutex);
+    }
+    if (trace.pendingReady) {
+      const TraceBuffer pending = trace.pending;
+      pthread_mutex_unlock(&trace.mutex);
+      fwrite(pending.data, 1, pending.size, trace.file);
+      pthread_mutex_lock(&trace.mutex);
+      trace.pendingReady = false;
+    } else {
+      break;
+    }
+  }
+  pthread_mutex_unlock(&trace.mutex);
+  return NULL;
+}
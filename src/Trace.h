@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdbool.h>
+
+// Chrome trace-event JSON writer fed by Profiler_Collect. Output can be opened in Perfetto or chrome://tracing.
+#ifdef DEPVIEW_PROFILER
+bool Trace_Open(const char* fileName);
+void Trace_Close();
+bool Trace_IsOpen();
+#else
+// Without DEPVIEW_PROFILER there are no events to write, Trace.c is not compiled
+static inline bool Trace_Open(const char* fileName) {
+  (void)fileName;
+  return false;
+}
+static inline void Trace_Close() {}
+static inline bool Trace_IsOpen() {
+  return false;
+}
+#endif
@@ -1,8 +1,14 @@
 #include "Workspace.h"
 
 #include "App.h"
+#include "Diff.h"
+#include "Focus.h"
 #include "Graph.h"
 #include "LogBook.h"
+#include "Profiler.h"
+#include "Reachability.h"
+#include "Reduction.h"
+#include "SpatialGrid.h"
 
 #include <raygui.h>
 
@@ -12,20 +18,79 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 typedef struct Workspace {
   size_t selectedNode;
+  size_t selectedId;  // Node.id of selected node, its index changes once finished nodes are dropped
   int diagramLayout;
+  float zoom;
   Vector2* coordinates;
+  size_t* coordinateIds;  // Node.id of every laid out node
   size_t coordinatesSize;
-  Vector2* previousCoordinates;
+  Vector2* previousCoordinates;  // by index in graph of last layout, as coordinates
+  Bitset animated;               // nodes having previous coordinates
   size_t previousCoordinatesSize;
+  Vector2 spaceSize;
+  SpatialGrid grid;
+  Focus focus;
+  bool focusIndexed;  // reverse adjacency of focus matches graph of last Workspace_BuildLayout
+  bool focused;       // only members of focus are laid out
+  int focusHops;
+  Reachability reachability;
+  bool reachabilityIndexed;  // matches graph of last Workspace_BuildLayout
+  int reachQuery;
+  Bitset highlighted;  // result of reachQuery for selected node
+  size_t highlightedSize;
+  Reduction reduction;
+  bool reductionBuilt;  // matches graph of last Workspace_BuildLayout
+  bool reduceEdges;     // redundant edges are not drawn
+  const Diff* diff;     // marks drawn over nodes and edges, NULL if none
+  const Bitset* filter;  // nodes let through by filter, NULL if all of them
+  Bitset filtered;       // members of focus let through by filter
+  const Bitset* shown;   // nodes laid out and drawn by last Workspace_Layout, NULL if all of them
 } Workspace;
 
-static void Workspace_DrawDiagram(Workspace* workspace, const Core* core, float procent, const Vector2* scrollOffset);
-static void BuildAbsoluteLayout(Vector2* result, const Graph* graph);
-static void BuildRelativeLayout(Vector2* result, const Graph* graph, const size_t selectedNode);
-static void DrawEdge(const Vector2* coordinates, const Edge* edge, const Vector2* scrollOffset);
+static void Workspace_DrawDiagram(Workspace* workspace,
+                                  const Core* core,
+                                  float procent,
+                                  const Rectangle* view,
+                                  const Vector2* scrollOffset);
+static void Workspace_DrawNode(Workspace* workspace,
+                               const Core* core,
+                               size_t i,
+                               Vector2 position,
+                               const Vector2* scrollOffset);
+static void Workspace_DrawDensityTiles(const Workspace* workspace,
+                                       const Rectangle* visibleArea,
+                                       const Vector2* scrollOffset);
+static Vector2 Workspace_NodePosition(const Workspace* workspace, size_t i, float procent);
+static void Workspace_KeepPreviousCoordinates(Workspace* workspace, const Graph* graph);
+static void Workspace_IndexEdges(Workspace* workspace, const Graph* graph);
+static void Workspace_DrawEdge(const Workspace* workspace,
+                               const Core* core,
+                               size_t i,
+                               float procent,
+                               const Rectangle* visibleArea,
+                               const Vector2* scrollOffset);
+static void BuildAbsoluteLayout(Vector2* result, const Graph* graph, const Bitset* shown);
+static void BuildRelativeLayout(Vector2* result, const Graph* graph, const size_t selectedNode, const Bitset* shown);
+static void BuildFocusLayout(Vector2* result,
+                             const Graph* graph,
+                             const Focus* focus,
+                             const Bitset* shown,
+                             size_t centre,
+                             int hops);
+static void Workspace_Layout(Workspace* workspace, const Graph* graph);
+static bool Workspace_IsVisible(const Workspace* workspace, size_t i);
+static void DrawEdge(Vector2 source,
+                     Vector2 destination,
+                     size_t sourceIndex,
+                     const Vector2* scrollOffset,
+                     float zoom,
+                     Color color);
+static Color DiffColor(int mark);
+static Rectangle Workspace_EdgeBounds(Vector2 source, Vector2 destination);
 
 typedef struct DiagramStyle {
   const float VERT_PADDING;
@@ -33,6 +98,11 @@ typedef struct DiagramStyle {
   const float NODE_H;
   const float NODE_W;
   const float MARGIN;
+  const float MIN_ZOOM;
+  const float MAX_ZOOM;
+  const float LABELS_MIN_ZOOM;  // below it nodes are drawn as plain rectangles
+  const float SHAPES_MIN_ZOOM;  // below it nodes are aggregated into density tiles
+  const float TILE_MIN_H;       // minimal on-screen height of density tile
 } DiagramStyle;
 
 DiagramStyle DiagramStyle_Default() {
@@ -42,6 +112,11 @@ DiagramStyle DiagramStyle_Default() {
       .NODE_W = 140,
       .NODE_H = 30,
       .MARGIN = 10,
+      .MIN_ZOOM = 1.0 / 512,
+      .MAX_ZOOM = 2.0,
+      .LABELS_MIN_ZOOM = 0.75,
+      .SHAPES_MIN_ZOOM = 0.2,
+      .TILE_MIN_H = 6,
   };
 }
 
@@ -51,9 +126,33 @@ size_t Workspace_SizeOf() {
 
 void Workspace_Init(Workspace* this) {
   this->selectedNode = 0;
+  this->selectedId = 0;
   this->diagramLayout = 0;
+  this->zoom = 1.0;
   this->coordinates = NULL;
+  this->coordinateIds = NULL;
+  this->coordinatesSize = 0;
   this->previousCoordinates = NULL;
+  this->animated = Bitset_Init();
+  this->previousCoordinatesSize = 0;
+  this->spaceSize = (Vector2){0, 0};
+  this->grid = SpatialGrid_Init();
+  this->focus = Focus_Init();
+  this->focusIndexed = false;
+  this->focused = false;
+  this->focusHops = 2;
+  this->reachability = Reachability_Init();
+  this->reachabilityIndexed = false;
+  this->reachQuery = EReach_None;
+  this->highlighted = Bitset_Init();
+  this->highlightedSize = 0;
+  this->reduction = Reduction_Init();
+  this->reductionBuilt = false;
+  this->reduceEdges = false;
+  this->diff = NULL;
+  this->filter = NULL;
+  this->filtered = Bitset_Init();
+  this->shown = NULL;
 }
 
 void Workspace_Destroy(Workspace* this) {
@@ -66,6 +165,14 @@ void Workspace_Destroy(Workspace* this) {
   if (this->previousCoordinates) {
     free(this->previousCoordinates);
   }
+  free(this->coordinateIds);
+  Bitset_Destroy(&this->animated);
+  SpatialGrid_Destroy(&this->grid);
+  Focus_Destroy(&this->focus);
+  Reachability_Destroy(&this->reachability);
+  Bitset_Destroy(&this->highlighted);
+  Reduction_Destroy(&this->reduction);
+  Bitset_Destroy(&this->filtered);
 }
 
 void Workspace_SetDiagramLayout(Workspace* this, int diagramLayout) {
@@ -76,121 +183,526 @@ int* Workspace_PointDiagramLayout(Workspace* this) {
   return &this->diagramLayout;
 }
 
-void Workspace_Draw(Workspace* workspace, const Core* core, float animationProgress, const Vector2* scrollOffset) {
+int* Workspace_PointFocusHops(Workspace* this) {
+  return &this->focusHops;
+}
+
+int* Workspace_PointReachQuery(Workspace* this) {
+  return &this->reachQuery;
+}
+
+size_t Workspace_HighlightedSize(const Workspace* this) {
+  return this->highlightedSize;
+}
+
+bool Workspace_GetReduceEdges(const Workspace* this) {
+  return this->reduceEdges;
+}
+
+void Workspace_SetReduceEdges(Workspace* this, const Graph* graph, bool reduceEdges) {
+  this->reduceEdges = reduceEdges;
+  if (reduceEdges && !this->reductionBuilt) {
+    PROFILER_SCOPE(EPhase_BuildLayout);
+    Reduction_Build(&this->reduction, graph);
+    this->reductionBuilt = true;
+  }
+}
+
+// Number of edges hidden by reduction, 0 when all edges are drawn
+size_t Workspace_RedundantEdgesSize(const Workspace* this) {
+  return this->reduceEdges && this->reductionBuilt ? this->reduction.redundantSize : 0;
+}
+
+// Diff is owned by caller and has to outlive its use by Workspace_Draw
+void Workspace_SetDiff(Workspace* this, const Diff* diff) {
+  this->diff = diff;
+}
+
+// Filter is owned by caller, it has to cover graph of next layout and outlive its use by Workspace_Draw
+void Workspace_SetFilter(Workspace* this, const Bitset* filter) {
+  this->filter = filter;
+}
+
+const Bitset* Workspace_GetFilter(const Workspace* this) {
+  return this->filter;
+}
+
+// Highlights nodes blocking selected node, or unblocked by it, as chosen by reachQuery
+void Workspace_UpdateHighlight(Workspace* this, const Graph* graph) {
+  this->highlightedSize = 0;
+  if (this->reachQuery == EReach_None) {
+    return;
+  }
+  if (!this->reachabilityIndexed) {
+    Reachability_Index(&this->reachability, graph);
+    this->reachabilityIndexed = true;
+  }
+  this->highlightedSize =
+      Reachability_Query(&this->reachability, graph, this->selectedNode, this->reachQuery, &this->highlighted);
+}
+
+size_t Workspace_GetSelectedNode(const Workspace* this) {
+  return this->selectedNode;
+}
+
+void Workspace_SetSelectedNode(Workspace* this, const Graph* graph, size_t selectedNode) {
+  this->selectedNode = selectedNode;
+  this->selectedId = selectedNode < graph->nodesSize ? graph->nodes[selectedNode].id : (size_t)-1;
+}
+
+size_t Workspace_PickNode(const Workspace* this, Vector2 position, const Vector2* scrollOffset) {
+  DiagramStyle ds = DiagramStyle_Default();
+  const Vector2 point = {
+      .x = (position.x - scrollOffset->x) / this->zoom,
+      .y = (position.y - scrollOffset->y) / this->zoom,
+  };
+
+  // node may stick out of its cell to the right and bottom only, so left and upper neighbours are checked too
+  const Vector2 cellSize = this->grid.cellSize;
+  GridRange range =
+      SpatialGrid_Range(&this->grid, 0, (Rectangle){point.x - cellSize.x, point.y - cellSize.y, cellSize.x, cellSize.y});
+  for (size_t row = range.row0; row < range.row1; ++row) {
+    for (size_t column = range.column0; column < range.column1; ++column) {
+      const size_t* cellEnd = SpatialGrid_CellEnd(&this->grid, column, row);
+      for (const size_t* it = SpatialGrid_CellBegin(&this->grid, column, row); it < cellEnd; ++it) {
+        const Vector2 node = this->coordinates[*it];
+        if (CheckCollisionPointRec(point, (Rectangle){node.x, node.y, ds.NODE_W, ds.NODE_H})) {
+          return *it;
+        }
+      }
+    }
+  }
+  return (size_t)-1;
+}
+
+void Workspace_DrawNodeTooltip(const Core* core, size_t nodeIndex, Vector2 position) {
+  if (nodeIndex >= core->currentGraph.nodesSize) {
+    return;
+  }
+  const Node* node = &core->currentGraph.nodes[nodeIndex];
+  char status[32];
+  snprintf(status, sizeof(status), "status: %s", LogBook_StatusName(node->status));
+  char timestamp[48];
+  struct tm timeInfo;
+  gmtime_r(&node->timestamp, &timeInfo);
+  strftime(timestamp, sizeof(timestamp), "added: %H:%M:%S %d-%m-%Y", &timeInfo);
+  const char* lines[] = {LogBook_GetNodeName(&core->logBook, node->nodeName), status, timestamp};
+
+  const float LINE_H = 16;
+  const float PADDING = 6;
+  float width = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    float lineWidth = MeasureText(lines[i], GuiGetStyle(DEFAULT, TEXT_SIZE));
+    width = lineWidth > width ? lineWidth : width;
+  }
+  Rectangle box = {position.x + 12, position.y + 12, width + 2 * PADDING, 3 * LINE_H + 2 * PADDING};
+  if (box.x + box.width > GetScreenWidth()) {
+    box.x = position.x - box.width - 4;
+  }
+  if (box.y + box.height > GetScreenHeight()) {
+    box.y = position.y - box.height - 4;
+  }
+
+  DrawRectangleRec(box, GetColor(GuiGetStyle(DEFAULT, BACKGROUND_COLOR)));
+  DrawRectangleLinesEx(box, 1, GetColor(GuiGetStyle(DEFAULT, LINE_COLOR)));
+  for (size_t i = 0; i < 3; ++i) {
+    GuiLabel((Rectangle){box.x + PADDING, box.y + PADDING + i * LINE_H, width, LINE_H}, lines[i]);
+  }
+}
+
+float Workspace_GetZoom(const Workspace* this) {
+  return this->zoom;
+}
+
+void Workspace_SetZoom(Workspace* this, float zoom) {
+  DiagramStyle ds = DiagramStyle_Default();
+  this->zoom = zoom < ds.MIN_ZOOM ? ds.MIN_ZOOM : zoom > ds.MAX_ZOOM ? ds.MAX_ZOOM : zoom;
+}
+
+void Workspace_Draw(Workspace* workspace,
+                    const Core* core,
+                    float animationProgress,
+                    const Rectangle* view,
+                    const Vector2* scrollOffset) {
   float deltaPosition = 1.0;
   if (animationProgress < 1.0) {
     deltaPosition = 0.5 + 0.5 * sinf(animationProgress * 3.14 - 1.57);
   }
-  Workspace_DrawDiagram(workspace, core, deltaPosition, scrollOffset);
+  Workspace_DrawDiagram(workspace, core, deltaPosition, view, scrollOffset);
 }
 
 void Workspace_BuildLayout(Workspace* workspace, const Graph* graph) {
-  if (workspace->previousCoordinates) {
-    free(workspace->previousCoordinates);
-    workspace->previousCoordinates = NULL;
-  }
-  if (workspace->coordinates != NULL) {
-    workspace->previousCoordinates = workspace->coordinates;
-    workspace->previousCoordinatesSize = workspace->coordinatesSize;
-  } else {
-    workspace->previousCoordinates = calloc(graph->nodesSize, sizeof(Vector2));
+  PROFILER_SCOPE(EPhase_BuildLayout);
+  workspace->selectedNode = Graph_NodeOfId(graph, workspace->selectedId);
+  workspace->focusIndexed = false;
+  workspace->reachabilityIndexed = false;
+  workspace->reductionBuilt = false;
+  if (workspace->reduceEdges) {
+    Reduction_Build(&workspace->reduction, graph);
+    workspace->reductionBuilt = true;
   }
+  Workspace_Layout(workspace, graph);
+}
+
+// Graph is the same as in last Workspace_BuildLayout, only selection or layout settings have changed
+void Workspace_Relayout(Workspace* workspace, const Graph* graph) {
+  PROFILER_SCOPE(EPhase_BuildLayout);
+  Workspace_Layout(workspace, graph);
+}
+
+bool Workspace_LayoutFollowsSelection(const Workspace* this) {
+  return this->diagramLayout != EDiagramLayout_Absolute;
+}
+
+static void Workspace_Layout(Workspace* workspace, const Graph* graph) {
+  Workspace_KeepPreviousCoordinates(workspace, graph);
   workspace->coordinates = calloc(graph->nodesSize, sizeof(Vector2));
+  const size_t idsSize = graph->nodesSize ? graph->nodesSize : 1;
+  workspace->coordinateIds = realloc(workspace->coordinateIds, idsSize * sizeof(size_t));
+  if (workspace->coordinateIds == NULL) {
+    perror("Cannot realloc memory for Workspace");
+    exit(10);
+  }
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    workspace->coordinateIds[i] = graph->nodes[i].id;
+  }
   workspace->coordinatesSize = graph->nodesSize;
-  if (workspace->diagramLayout == 0) {
-    BuildAbsoluteLayout(workspace->coordinates, graph);
+  workspace->focused = workspace->diagramLayout == EDiagramLayout_Focus && workspace->selectedNode < graph->nodesSize;
+  workspace->shown = workspace->filter && workspace->filter->size >= graph->nodesSize ? workspace->filter : NULL;
+  if (workspace->focused) {
+    if (!workspace->focusIndexed) {
+      Focus_Index(&workspace->focus, graph);
+      workspace->focusIndexed = true;
+    }
+    Focus_Compute(&workspace->focus, graph, workspace->selectedNode, workspace->focusHops);
+    if (workspace->shown) {
+      Bitset_Resize(&workspace->filtered, graph->nodesSize);
+      for (size_t w = 0; w < (graph->nodesSize + 63) / 64; ++w) {
+        workspace->filtered.words[w] = workspace->focus.visible.words[w] & workspace->shown->words[w];
+      }
+      workspace->shown = &workspace->filtered;
+    } else {
+      workspace->shown = &workspace->focus.visible;
+    }
+    BuildFocusLayout(workspace->coordinates, graph, &workspace->focus, workspace->shown, workspace->selectedNode,
+                     workspace->focusHops);
+  } else if (workspace->diagramLayout == EDiagramLayout_Absolute) {
+    BuildAbsoluteLayout(workspace->coordinates, graph, workspace->shown);
   } else {
     size_t centralNode = workspace->selectedNode;
     if (centralNode >= graph->nodesSize) {
       centralNode = (size_t)-1;
     }
-    BuildRelativeLayout(workspace->coordinates, graph, centralNode);
+    BuildRelativeLayout(workspace->coordinates, graph, centralNode, workspace->shown);
+  }
+
+  DiagramStyle ds = DiagramStyle_Default();
+  workspace->spaceSize = (Vector2){0, 0};
+  for (const Vector2* it = workspace->coordinates; it < workspace->coordinates + workspace->coordinatesSize; ++it) {
+    if (!Workspace_IsVisible(workspace, it - workspace->coordinates)) {
+      continue;
+    }
+    if (workspace->spaceSize.x < it->x) {
+      workspace->spaceSize.x = it->x;
+    }
+    if (workspace->spaceSize.y < it->y) {
+      workspace->spaceSize.y = it->y;
+    }
   }
+  workspace->spaceSize.x += ds.NODE_W + ds.VERT_PADDING;
+  workspace->spaceSize.y += ds.NODE_H + ds.HORI_PADDING;
+
+  SpatialGrid_Build(&workspace->grid, workspace->coordinates, graph->nodes, graph->nodesSize, workspace->shown,
+                    (Vector2){ds.MARGIN, ds.MARGIN},
+                    (Vector2){ds.NODE_W + ds.HORI_PADDING, ds.NODE_H + ds.VERT_PADDING});
+  Workspace_IndexEdges(workspace, graph);
   //  if (! workspace->previousCoordinates)
   //  {
   //      workspace->previousCoordinates = workspace->coordinates;
   //  }
+  Workspace_UpdateHighlight(workspace, graph);
 }
 
 Vector2 Workspace_GetSpaceSize(const Workspace* this, const Rectangle* panelRect) {
-  DiagramStyle ds = DiagramStyle_Default();
-  float max_x = 0;
-  float max_y = 0;
-
-  for (const Vector2* it = this->coordinates; it < this->coordinates + this->coordinatesSize; ++it) {
-    if (max_x < it->x) {
-      max_x = it->x;
-    }
-    if (max_y < it->y) {
-      max_y = it->y;
-    }
-  }
-
-  float dynamicWidth = max_x + ds.NODE_W + ds.VERT_PADDING;
-  float dynamicHeight = max_y + ds.NODE_H + ds.HORI_PADDING;
+  float dynamicWidth = this->spaceSize.x * this->zoom;
+  float dynamicHeight = this->spaceSize.y * this->zoom;
   return (Vector2){
       (dynamicWidth > panelRect->width - BORDER_WIDTH) ? dynamicWidth : panelRect->width - BORDER_WIDTH,
       (dynamicHeight > panelRect->height - BORDER_WIDTH) ? dynamicHeight : panelRect->height - BORDER_WIDTH};
 }
 
-static void Workspace_DrawDiagram(Workspace* workspace, const Core* core, float procent, const Vector2* scrollOffset) {
+static void Workspace_DrawDiagram(Workspace* workspace,
+                                  const Core* core,
+                                  float procent,
+                                  const Rectangle* view,
+                                  const Vector2* scrollOffset) {
   if (!workspace) {
     return;
   }
+  PROFILER_SCOPE(EPhase_DrawDiagram);
 
   DiagramStyle ds = DiagramStyle_Default();
   const Graph* graph = &core->currentGraph;
-  const Graph* oldGraph = &core->oldGraph;
-  const Vector2* oldCoords = workspace->previousCoordinates;
-  const Vector2* newCoords = workspace->coordinates;
+  const float zoom = workspace->zoom;
+  const Rectangle visibleArea = {
+      .x = (view->x - scrollOffset->x) / zoom,
+      .y = (view->y - scrollOffset->y) / zoom,
+      .width = view->width / zoom,
+      .height = view->height / zoom,
+  };
 
-  size_t nodesSize = graph->nodesSize < oldGraph->nodesSize ? oldGraph->nodesSize : graph->nodesSize;
-  Vector2 drawCoords[nodesSize];
-  for (size_t i = 0; i != nodesSize; ++i) {
-    if (i >= oldGraph->nodesSize) {
-      drawCoords[i] = newCoords[i];
-    } else if (i >= graph->nodesSize) {
-      drawCoords[i] = oldCoords[i];
-    } else {
-      drawCoords[i].x = oldCoords[i].x * (1.0 - procent) + newCoords[i].x * procent;
-      drawCoords[i].y = oldCoords[i].y * (1.0 - procent) + newCoords[i].y * procent;
+  if (zoom < ds.SHAPES_MIN_ZOOM) {
+    Workspace_DrawDensityTiles(workspace, &visibleArea, scrollOffset);
+    return;
+  }
+
+  if (procent < 1.0) {
+    // nodes are moving, so grid of final positions cannot be used for culling
+    for (size_t i = 0; i < graph->nodesSize; ++i) {
+      if (!Workspace_IsVisible(workspace, i)) {
+        continue;
+      }
+      Vector2 position = Workspace_NodePosition(workspace, i, procent);
+      if (CheckCollisionRecs(visibleArea, (Rectangle){position.x, position.y, ds.NODE_W, ds.NODE_H})) {
+        Workspace_DrawNode(workspace, core, i, position, scrollOffset);
+      }
+    }
+  } else {
+    // node may stick out of its cell to the right and bottom only
+    Rectangle queryArea = visibleArea;
+    queryArea.x -= workspace->grid.cellSize.x;
+    queryArea.y -= workspace->grid.cellSize.y;
+    queryArea.width += workspace->grid.cellSize.x;
+    queryArea.height += workspace->grid.cellSize.y;
+    GridRange range = SpatialGrid_Range(&workspace->grid, 0, queryArea);
+    for (size_t row = range.row0; row < range.row1; ++row) {
+      for (size_t column = range.column0; column < range.column1; ++column) {
+        const size_t* cellEnd = SpatialGrid_CellEnd(&workspace->grid, column, row);
+        for (const size_t* it = SpatialGrid_CellBegin(&workspace->grid, column, row); it < cellEnd; ++it) {
+          Workspace_DrawNode(workspace, core, *it, workspace->coordinates[*it], scrollOffset);
+        }
+      }
     }
   }
 
-  for (size_t i = 0; i < graph->nodesSize; ++i) {
-    Node* node = &graph->nodes[i];
-
-    switch (node->status) {
-      case EStatus_Finished:
-        GuiSetState(STATE_DISABLED);
-        break;
-      case EStatus_Ongoing:
-        GuiSetState(STATE_FOCUSED);
-        break;
-      default:
-        if (i == workspace->selectedNode) {
-          GuiSetState(STATE_PRESSED);
-        } else {
-          GuiSetState(STATE_NORMAL);
+  GuiSetState(STATE_NORMAL);
+
+  if (procent < 1.0) {
+    for (size_t i = 0; i < graph->edgesSize; ++i) {
+      Workspace_DrawEdge(workspace, core, i, procent, &visibleArea, scrollOffset);
+    }
+  } else {
+    // every edge is kept by one tile of one level, so none is drawn twice
+    for (size_t level = 0; level < workspace->grid.levelsSize; ++level) {
+      GridRange range = SpatialGrid_EdgeRange(&workspace->grid, level, visibleArea);
+      for (size_t row = range.row0; row < range.row1; ++row) {
+        for (size_t column = range.column0; column < range.column1; ++column) {
+          const size_t* end = SpatialGrid_EdgesEnd(&workspace->grid, level, column, row);
+          for (const size_t* it = SpatialGrid_EdgesBegin(&workspace->grid, level, column, row); it < end; ++it) {
+            Workspace_DrawEdge(workspace, core, *it, procent, &visibleArea, scrollOffset);
+          }
         }
-        break;
+      }
     }
+  }
 
-    if (GuiButton(
-            (Rectangle){drawCoords[i].x + scrollOffset->x, drawCoords[i].y + scrollOffset->y, ds.NODE_W, ds.NODE_H},
-            LogBook_GetNodeName(&core->logBook, node->nodeName))) {
-      workspace->selectedNode = i;
-    };
+  // edges removed since older snapshot are no longer in newer graph, but both their nodes are
+  const Diff* diff = workspace->diff;
+  if (diff && core->currentLog == diff->to) {
+    for (const DiffEdge* edge = diff->edges; edge < diff->edges + diff->edgesSize; ++edge) {
+      const size_t sourceNode = Graph_NodeOfId(graph, edge->source);
+      const size_t destinationNode = Graph_NodeOfId(graph, edge->destination);
+      if (edge->mark != EDiffMark_Removed || sourceNode == (size_t)-1 || destinationNode == (size_t)-1 ||
+          !Workspace_IsVisible(workspace, sourceNode) || !Workspace_IsVisible(workspace, destinationNode)) {
+        continue;
+      }
+      const Vector2 source = Workspace_NodePosition(workspace, sourceNode, procent);
+      const Vector2 destination = Workspace_NodePosition(workspace, destinationNode, procent);
+      if (!CheckCollisionRecs(visibleArea, Workspace_EdgeBounds(source, destination))) {
+        continue;
+      }
+      DrawEdge(source, destination, sourceNode, scrollOffset, zoom, Fade(DiffColor(edge->mark), 0.6));
+    }
   }
+}
 
-  GuiSetState(STATE_NORMAL);
+static void Workspace_DrawEdge(const Workspace* workspace,
+                               const Core* core,
+                               size_t i,
+                               float procent,
+                               const Rectangle* visibleArea,
+                               const Vector2* scrollOffset) {
+  const Graph* graph = &core->currentGraph;
+  const Bitset* redundant = Workspace_RedundantEdgesSize(workspace) > 0 ? &workspace->reduction.redundant : NULL;
+  if (redundant && i < redundant->size && Bitset_Test(redundant, i)) {
+    return;
+  }
+  const Edge* edge = &graph->edges[i];
+  if (!Workspace_IsVisible(workspace, edge->source) || !Workspace_IsVisible(workspace, edge->destination)) {
+    return;
+  }
+  Vector2 source = Workspace_NodePosition(workspace, edge->source, procent);
+  Vector2 destination = Workspace_NodePosition(workspace, edge->destination, procent);
+  if (CheckCollisionRecs(*visibleArea, Workspace_EdgeBounds(source, destination))) {
+    const int mark = workspace->diff ? Diff_EdgeMark(workspace->diff, graph->nodes[edge->source].id,
+                                                     graph->nodes[edge->destination].id)
+                                     : EDiffMark_None;
+    DrawEdge(source, destination, edge->source, scrollOffset, workspace->zoom,
+             mark != EDiffMark_None ? DiffColor(mark) : GetColor(GuiGetStyle(DEFAULT, LINE_COLOR)));
+  }
+}
+
+static void Workspace_DrawNode(Workspace* workspace,
+                               const Core* core,
+                               size_t i,
+                               Vector2 position,
+                               const Vector2* scrollOffset) {
+  DiagramStyle ds = DiagramStyle_Default();
+  const Node* node = &core->currentGraph.nodes[i];
+  const float zoom = workspace->zoom;
+  const Rectangle bounds = {
+      .x = scrollOffset->x + position.x * zoom,
+      .y = scrollOffset->y + position.y * zoom,
+      .width = ds.NODE_W * zoom,
+      .height = ds.NODE_H * zoom,
+  };
+
+  const bool highlighted = workspace->highlightedSize > 0 && Bitset_Test(&workspace->highlighted, i);
+  const int mark = workspace->diff ? Diff_NodeMark(workspace->diff, node->id) : EDiffMark_None;
+  if (zoom < ds.LABELS_MIN_ZOOM) {
+    DrawRectangleRec(bounds, Workspace_StatusColor(node->status, i == workspace->selectedNode || highlighted));
+    if (mark != EDiffMark_None) {
+      DrawRectangleLinesEx(bounds, 2, DiffColor(mark));
+    }
+    return;
+  }
+
+  switch (node->status) {
+    case EStatus_Finished:
+      GuiSetState(STATE_DISABLED);
+      break;
+    case EStatus_Ongoing:
+      GuiSetState(STATE_FOCUSED);
+      break;
+    default:
+      if (i == workspace->selectedNode) {
+        GuiSetState(STATE_PRESSED);
+      } else {
+        GuiSetState(STATE_NORMAL);
+      }
+      break;
+  }
+
+  GuiButton(bounds, LogBook_GetNodeName(&core->logBook, node->nodeName));
+  if (highlighted) {
+    DrawRectangleLinesEx(bounds, 3, GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_PRESSED)));
+  }
+  if (mark != EDiffMark_None) {
+    // outside of bounds, so it does not cover highlight
+    DrawRectangleLinesEx((Rectangle){bounds.x - 3, bounds.y - 3, bounds.width + 6, bounds.height + 6}, 3,
+                         DiffColor(mark));
+  }
+}
+
+static void Workspace_DrawDensityTiles(const Workspace* workspace,
+                                       const Rectangle* visibleArea,
+                                       const Vector2* scrollOffset) {
+  DiagramStyle ds = DiagramStyle_Default();
+  const SpatialGrid* grid = &workspace->grid;
+  const float zoom = workspace->zoom;
+
+  // coarsest level which still gives tiles tall enough to be distinguished
+  size_t level = 0;
+  while (level + 1 < grid->levelsSize && SpatialGrid_TileSize(grid, level).y * zoom < ds.TILE_MIN_H) {
+    ++level;
+  }
+  const Vector2 tileSize = SpatialGrid_TileSize(grid, level);
+  const float tileCapacity = (float)((size_t)1 << level) * (float)((size_t)1 << level);
+
+  GridRange range = SpatialGrid_Range(grid, level, *visibleArea);
+  for (size_t row = range.row0; row < range.row1; ++row) {
+    for (size_t column = range.column0; column < range.column1; ++column) {
+      const unsigned int* counts = SpatialGrid_Tile(grid, level, column, row);
+      unsigned int total = 0;
+      EStatus dominant = EStatus_Waiting;
+      for (size_t s = 0; s < SPATIALGRID_STATUSES; ++s) {
+        total += counts[s];
+        if (counts[s] > counts[dominant]) {
+          dominant = s;
+        }
+      }
+      if (total == 0) {
+        continue;
+      }
+      const float density = total / tileCapacity > 1.0 ? 1.0 : total / tileCapacity;
+      const Rectangle bounds = {
+          .x = scrollOffset->x + (grid->origin.x + column * tileSize.x) * zoom,
+          .y = scrollOffset->y + (grid->origin.y + row * tileSize.y) * zoom,
+          .width = tileSize.x * zoom,
+          .height = tileSize.y * zoom,
+      };
+      DrawRectangleRec(bounds, Fade(Workspace_StatusColor(dominant, false), 0.35 + 0.65 * density));
+    }
+  }
+}
+
+static Vector2 Workspace_NodePosition(const Workspace* workspace, size_t i, float procent) {
+  if (procent >= 1.0 || i >= workspace->previousCoordinatesSize || !Bitset_Test(&workspace->animated, i)) {
+    return workspace->coordinates[i];  // node new to this layout appears at its place
+  }
+  const Vector2* oldCoords = workspace->previousCoordinates;
+  const Vector2* newCoords = workspace->coordinates;
+  return (Vector2){
+      .x = oldCoords[i].x * (1.0 - procent) + newCoords[i].x * procent,
+      .y = oldCoords[i].y * (1.0 - procent) + newCoords[i].y * procent,
+  };
+}
 
+// Node keeps its id while dropping finished nodes moves others to free indexes, so positions of last layout are
+// moved to indexes the same nodes have in graph
+// Edges between shown nodes are put in grid by bounds of final layout, so drawing them costs in edges crossing view
+static void Workspace_IndexEdges(Workspace* workspace, const Graph* graph) {
+  Rectangle* bounds = calloc(graph->edgesSize ? graph->edgesSize : 1, sizeof(Rectangle));
+  if (bounds == NULL) {
+    perror("Cannot calloc memory for Workspace");
+    exit(10);
+  }
+  Bitset shown = Bitset_Init();
+  Bitset_Resize(&shown, graph->edgesSize);
   for (size_t i = 0; i < graph->edgesSize; ++i) {
-    DrawEdge(drawCoords, &graph->edges[i], scrollOffset);
+    const Edge* edge = &graph->edges[i];
+    if (Workspace_IsVisible(workspace, edge->source) && Workspace_IsVisible(workspace, edge->destination)) {
+      Bitset_Set(&shown, i);
+      bounds[i] = Workspace_EdgeBounds(workspace->coordinates[edge->source], workspace->coordinates[edge->destination]);
+    }
+  }
+  SpatialGrid_BuildEdges(&workspace->grid, bounds, graph->edgesSize, &shown);
+  Bitset_Destroy(&shown);
+  free(bounds);
+}
+
+static void Workspace_KeepPreviousCoordinates(Workspace* workspace, const Graph* graph) {
+  free(workspace->previousCoordinates);
+  workspace->previousCoordinates = calloc(graph->nodesSize ? graph->nodesSize : 1, sizeof(Vector2));
+  if (workspace->previousCoordinates == NULL) {
+    perror("Cannot calloc memory for Workspace");
+    exit(10);
+  }
+  workspace->previousCoordinatesSize = graph->nodesSize;
+  Bitset_Resize(&workspace->animated, graph->nodesSize);
+  for (size_t j = 0; j < workspace->coordinatesSize; ++j) {
+    const size_t i = Graph_NodeOfId(graph, workspace->coordinateIds[j]);
+    if (i < graph->nodesSize) {
+      workspace->previousCoordinates[i] = workspace->coordinates[j];
+      Bitset_Set(&workspace->animated, i);
+    }
   }
+  free(workspace->coordinates);
+  workspace->coordinates = NULL;
 }
 
-static void BuildAbsoluteLayout(Vector2* result, const Graph* graph) {
+// Nodes not shown still have their level computed, as shown ones depend on it, but take no place in column
+static void BuildAbsoluteLayout(Vector2* result, const Graph* graph, const Bitset* shown) {
   DiagramStyle ds = DiagramStyle_Default();
   int nodesInColumn[16];
   memset(&nodesInColumn, '\0', sizeof(nodesInColumn));
@@ -230,13 +742,13 @@ static void BuildAbsoluteLayout(Vector2* result, const Graph* graph) {
 
     result[i].x = ds.MARGIN + levelsOfDependency[i] * (ds.NODE_W + ds.HORI_PADDING);
     result[i].y = ds.MARGIN + nodesInColumn[levelsOfDependency[i]] * (ds.NODE_H + ds.VERT_PADDING);
-    ++nodesInColumn[levelsOfDependency[i]];
+    nodesInColumn[levelsOfDependency[i]] += !shown || Bitset_Test(shown, i);
   }
   DynamicArray_Destroy(stack);
   free(stack);
 }
 
-static void BuildRelativeLayout(Vector2* result, const Graph* graph, const size_t startNode) {
+static void BuildRelativeLayout(Vector2* result, const Graph* graph, const size_t startNode, const Bitset* shown) {
   DiagramStyle ds = DiagramStyle_Default();
   int minLevel = 0;
   int levelsOfDependency[graph->nodesSize];
@@ -297,39 +809,100 @@ static void BuildRelativeLayout(Vector2* result, const Graph* graph, const size_
     }
     result[i].x = ds.MARGIN + (levelsOfDependency[i] - minLevel) * (ds.NODE_W + ds.HORI_PADDING);
     result[i].y = ds.MARGIN + nodesInColumn[levelsOfDependency[i] - minLevel] * (ds.NODE_H + ds.VERT_PADDING);
-    ++nodesInColumn[levelsOfDependency[i] - minLevel];
+    nodesInColumn[levelsOfDependency[i] - minLevel] += !shown || Bitset_Test(shown, i);
   }
   DynamicArray_Destroy(stack);
   free(stack);
 }
 
-static void DrawEdge(const Vector2* coordinates, const Edge* edge, const Vector2* scrollOffset) {
+// Shown members of focus are placed in columns by their distance from centre, the rest is hidden under centre
+static void BuildFocusLayout(Vector2* result,
+                             const Graph* graph,
+                             const Focus* focus,
+                             const Bitset* shown,
+                             size_t centre,
+                             int hops) {
+  DiagramStyle ds = DiagramStyle_Default();
+  hops = hops > FOCUS_MAX_HOPS ? FOCUS_MAX_HOPS : hops;
+  int nodesInColumn[2 * FOCUS_MAX_HOPS + 1];
+  memset(&nodesInColumn, '\0', sizeof(nodesInColumn));
+  for (size_t i = Bitset_Next(shown, 0); i < graph->nodesSize; i = Bitset_Next(shown, i + 1)) {
+    const int column = focus->hops[i] + hops;
+    result[i].x = ds.MARGIN + column * (ds.NODE_W + ds.HORI_PADDING);
+    result[i].y = ds.MARGIN + nodesInColumn[column] * (ds.NODE_H + ds.VERT_PADDING);
+    ++nodesInColumn[column];
+  }
+  for (size_t i = 0; i < graph->nodesSize; ++i) {
+    if (!Bitset_Test(shown, i)) {
+      result[i] = result[centre];
+    }
+  }
+}
+
+static bool Workspace_IsVisible(const Workspace* workspace, size_t i) {
+  return !workspace->shown || Bitset_Test(workspace->shown, i);
+}
+
+const Vector2* Workspace_GetCoordinates(const Workspace* this) {
+  return this->coordinates;
+}
+
+Vector2 Workspace_NodeSize() {
   DiagramStyle ds = DiagramStyle_Default();
+  return (Vector2){ds.NODE_W, ds.NODE_H};
+}
+
+Color Workspace_StatusColor(int status, bool selected) {
+  if (selected) {
+    return GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_PRESSED));
+  }
+  switch (status) {
+    case EStatus_Finished:
+      return GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_DISABLED));
+    case EStatus_Ongoing:
+      return GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_FOCUSED));
+    default:
+      return GetColor(GuiGetStyle(BUTTON, BORDER_COLOR_NORMAL));
+  }
+}
 
-  Vector2 strip[8];
+// Centre of node in zoomed panel space, as scrolled by Gui
+Vector2 Workspace_GetNodeCenter(const Workspace* this, size_t nodeIndex) {
+  if (nodeIndex >= this->coordinatesSize) {
+    return (Vector2){0, 0};
+  }
+  DiagramStyle ds = DiagramStyle_Default();
+  return (Vector2){
+      .x = (this->coordinates[nodeIndex].x + ds.NODE_W / 2) * this->zoom,
+      .y = (this->coordinates[nodeIndex].y + ds.NODE_H / 2) * this->zoom,
+  };
+}
+
+// Route of edge in diagram space, shared by drawing and export
+void Workspace_EdgeStrip(Vector2 source, Vector2 destination, size_t sourceIndex, Vector2* strip) {
+  DiagramStyle ds = DiagramStyle_Default();
 
   // middle on bottom side of source node
   {
-    strip[0].x = scrollOffset->x + coordinates[edge->source].x + ds.NODE_W / 2;
-    strip[0].y = scrollOffset->y + coordinates[edge->source].y + ds.NODE_H;
+    strip[0].x = source.x + ds.NODE_W / 2;
+    strip[0].y = source.y + ds.NODE_H;
   }
 
   // Line on "edge-bus"
   {
     strip[1].x = strip[0].x;
-    strip[1].y = strip[0].y + ds.VERT_PADDING / 5 + (edge->source % 9);  // here to add small jumps to distinguish lines
+    strip[1].y = strip[0].y + ds.VERT_PADDING / 5 + (sourceIndex % 9);  // here to add small jumps to distinguish lines
 
-    strip[2].x = scrollOffset->x + coordinates[edge->destination].x - ds.HORI_PADDING / 5 -
-                 (edge->source % 9);  // here to add small jumps to distinguish lines
+    strip[2].x = destination.x - ds.HORI_PADDING / 5 - (sourceIndex % 9);  // here to add small jumps to distinguish lines
     strip[2].y = strip[1].y;
 
     strip[3].x = strip[2].x;
-    strip[3].y = scrollOffset->y + coordinates[edge->destination].y + ds.NODE_H / 2;
+    strip[3].y = destination.y + ds.NODE_H / 2;
   }
 
   // middle point on left side of destination node
   {
-    strip[4].x = scrollOffset->x + coordinates[edge->destination].x;
+    strip[4].x = destination.x;
     strip[4].y = strip[3].y;
   }
 
@@ -341,6 +914,43 @@ static void DrawEdge(const Vector2* coordinates, const Edge* edge, const Vector2
     strip[6].y = strip[4].y + ds.VERT_PADDING / 4;
     strip[7] = strip[4];
   }
+}
+
+static void DrawEdge(Vector2 source,
+                     Vector2 destination,
+                     size_t sourceIndex,
+                     const Vector2* scrollOffset,
+                     float zoom,
+                     Color color) {
+  Vector2 strip[WORKSPACE_EDGE_STRIP_SIZE];
+  Workspace_EdgeStrip(source, destination, sourceIndex, strip);
+  for (size_t i = 0; i < WORKSPACE_EDGE_STRIP_SIZE; ++i) {
+    strip[i].x = scrollOffset->x + strip[i].x * zoom;
+    strip[i].y = scrollOffset->y + strip[i].y * zoom;
+  }
+
+  DrawLineStrip(strip, WORKSPACE_EDGE_STRIP_SIZE, color);
+}
 
-  DrawLineStrip(strip, 8, GetColor(GuiGetStyle(DEFAULT, LINE_COLOR)));
+// Area of diagram an edge between nodes at given positions may cover
+static Rectangle Workspace_EdgeBounds(Vector2 source, Vector2 destination) {
+  DiagramStyle ds = DiagramStyle_Default();
+  return (Rectangle){
+      .x = fminf(source.x, destination.x) - ds.HORI_PADDING,
+      .y = fminf(source.y, destination.y),
+      .width = fabsf(source.x - destination.x) + ds.NODE_W + ds.HORI_PADDING,
+      .height = fabsf(source.y - destination.y) + ds.NODE_H + ds.VERT_PADDING,
+  };
+}
+
+// Colours of diff are not taken from style, added and removed have to read as green and red in every one of them
+static Color DiffColor(int mark) {
+  switch (mark) {
+    case EDiffMark_Added:
+      return LIME;
+    case EDiffMark_Removed:
+      return RED;
+    default:
+      return GOLD;
+  }
 }
@@ -3,11 +3,18 @@ typedef struct Workspace Workspace;
 typedef struct LogBook LogBook;
 typedef struct Graph Graph;
 typedef struct Vector2 Vector2;
+typedef struct Diff Diff;
+typedef struct Bitset Bitset;
 
 #include "Core.h"
 
+#include <stdbool.h>
 #include <stddef.h>
 
+#define WORKSPACE_EDGE_STRIP_SIZE 8
+
+typedef enum { EDiagramLayout_Absolute, EDiagramLayout_Relative, EDiagramLayout_Focus } EDiagramLayout;
+
 void Workspace_Init(Workspace* this);
 size_t Workspace_SizeOf();
 void Workspace_Destroy(Workspace* this);
@@ -16,7 +23,36 @@ Vector2 Workspace_GetSpaceSize(const Workspace* this, const Rectangle* panelRect
 
 void Workspace_SetDiagramLayout(Workspace* this, int diagramLayout);
 int* Workspace_PointDiagramLayout(Workspace* this);
+int* Workspace_PointFocusHops(Workspace* this);
+bool Workspace_LayoutFollowsSelection(const Workspace* this);
+int* Workspace_PointReachQuery(Workspace* this);
+void Workspace_UpdateHighlight(Workspace* this, const Graph* graph);
+size_t Workspace_HighlightedSize(const Workspace* this);
+bool Workspace_GetReduceEdges(const Workspace* this);
+void Workspace_SetReduceEdges(Workspace* this, const Graph* graph, bool reduceEdges);
+size_t Workspace_RedundantEdgesSize(const Workspace* this);
+void Workspace_SetDiff(Workspace* this, const Diff* diff);
+void Workspace_SetFilter(Workspace* this, const Bitset* filter);
+const Bitset* Workspace_GetFilter(const Workspace* this);
+
+size_t Workspace_GetSelectedNode(const Workspace* this);
+void Workspace_SetSelectedNode(Workspace* this, const Graph* graph, size_t selectedNode);
+size_t Workspace_PickNode(const Workspace* this, Vector2 position, const Vector2* scrollOffset);
+void Workspace_DrawNodeTooltip(const Core* core, size_t nodeIndex, Vector2 position);
+
+float Workspace_GetZoom(const Workspace* this);
+void Workspace_SetZoom(Workspace* this, float zoom);
 
 void Workspace_BuildLayout(Workspace* workspace, const Graph* graph);
-
-void Workspace_Draw(Workspace* this, const Core* core, float animationProgress, const Vector2* scrollOffset);
+void Workspace_Relayout(Workspace* workspace, const Graph* graph);
+const Vector2* Workspace_GetCoordinates(const Workspace* this);
+Vector2 Workspace_NodeSize();
+Color Workspace_StatusColor(int status, bool selected);
+Vector2 Workspace_GetNodeCenter(const Workspace* this, size_t nodeIndex);
+void Workspace_EdgeStrip(Vector2 source, Vector2 destination, size_t sourceIndex, Vector2* strip);
+
+void Workspace_Draw(Workspace* this,
+                    const Core* core,
+                    float animationProgress,
+                    const Rectangle* view,
+                    const Vector2* scrollOffset);
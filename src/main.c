@@ -1,36 +1,138 @@
 #include <App.h>
+#include <Graph.h>
+#include <Headless.h>
+#include <Profiler.h>
+#include <Render.h>
+#include <Trace.h>
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 typedef struct Arguments {
-  char* filePath;
+  LogSource* sources;  // logs given, merged into one
+  size_t sourcesSize;
+  int targetFps;
+  bool idleMode;
+  EVerbosity verbosity;
+  char* traceFile;
+  bool headless;
+  HeadlessQuery query;
+  RenderQuery render;
+  Retention retention;
 } Arguments;
 
 Arguments parseArgv(int argc, char** argv) {
   Arguments res;
-  res.filePath = NULL;
+  res.sources = calloc(argc, sizeof(LogSource));
+  res.sourcesSize = 0;
+  const char* namePrefix = NULL;  // of next log
+  res.targetFps = 60;
+  res.idleMode = true;
+  res.verbosity = EVerbosity_Errors;
+  res.traceFile = NULL;
+  res.headless = false;
+  res.query = (HeadlessQuery){.at = NULL, .format = EDumpFormat_Text, .every = 0, .exportFile = NULL};
+  res.render = (RenderQuery){.outputDir = NULL, .every = 1, .workers = 0};
+  res.retention = (Retention){.entries = 0, .seconds = 0};
 
-  if (argc == 2) {
-    if (access(argv[1], F_OK)) {
-      printf("Cannot find file %s\n", argv[1]);
-      return res;
+  for (int i = 1; i < argc; ++i) {
+    if (0 == strcmp(argv[i], "--fps") && i + 1 < argc) {
+      res.targetFps = atoi(argv[++i]);
+    } else if (0 == strcmp(argv[i], "--no-idle")) {
+      res.idleMode = false;
+    } else if (0 == strcmp(argv[i], "--quiet")) {
+      res.verbosity = EVerbosity_Quiet;
+    } else if (0 == strcmp(argv[i], "--verbose")) {
+      res.verbosity = EVerbosity_Verbose;
+    } else if (0 == strcmp(argv[i], "--trace-out") && i + 1 < argc) {
+      res.traceFile = argv[++i];
+#ifndef DEPVIEW_PROFILER
+      fprintf(stderr, "DepView was built without DEPVIEW_PROFILER, trace will be empty\n");
+#endif
+    } else if (0 == strcmp(argv[i], "--headless")) {
+      res.headless = true;
+    } else if (0 == strcmp(argv[i], "--at") && i + 1 < argc) {
+      res.query.at = argv[++i];
+    } else if (0 == strcmp(argv[i], "--dump") && i + 1 < argc) {
+      ++i;
+      if (0 == strcmp(argv[i], "json")) {
+        res.query.format = EDumpFormat_Json;
+      } else if (0 == strcmp(argv[i], "text")) {
+        res.query.format = EDumpFormat_Text;
+      } else {
+        fprintf(stderr, "Unknown dump format %s, use text or json\n", argv[i]);
+        exit(2);
+      }
+    } else if (0 == strcmp(argv[i], "--export") && i + 1 < argc) {
+      res.query.exportFile = argv[++i];
+    } else if (0 == strcmp(argv[i], "--every") && i + 1 < argc) {
+      res.query.every = strtoull(argv[++i], NULL, 10);
+      res.render.every = res.query.every;
+    } else if (0 == strcmp(argv[i], "--render") && i + 1 < argc) {
+      res.render.outputDir = argv[++i];
+    } else if (0 == strcmp(argv[i], "--workers") && i + 1 < argc) {
+      res.render.workers = strtoull(argv[++i], NULL, 10);
+    } else if (0 == strcmp(argv[i], "--prefix") && i + 1 < argc) {
+      namePrefix = argv[++i];
+    } else if (0 == strcmp(argv[i], "--keep-finished") && i + 1 < argc) {
+      if (!Graph_ParseRetention(argv[++i], &res.retention)) {
+        fprintf(stderr, "Cannot parse retention %s, expected entries or seconds with s, m, h or d unit\n", argv[i]);
+      }
+    } else if (access(argv[i], F_OK)) {
+      fprintf(stderr, "Cannot find file %s\n", argv[i]);
+    } else {
+      res.sources[res.sourcesSize++] = (LogSource){.fileName = argv[i], .namePrefix = namePrefix};
+      namePrefix = NULL;
     }
-    res.filePath = argv[1];
   }
 
   return res;
 }
 
 int main(int argc, char** argv) {
-  App* app = malloc(App_SizeOf());
-
+  PROFILER_INIT();
   Arguments arguments = parseArgv(argc, argv);
+  if (arguments.render.outputDir) {
+    arguments.render.sources = arguments.sources;
+    arguments.render.sourcesSize = arguments.sourcesSize;
+    arguments.render.verbosity = arguments.verbosity;
+    arguments.render.retention = arguments.retention;
+    if (arguments.traceFile) {
+      Trace_Open(arguments.traceFile);
+    }
+    const int result = Render_Run(&arguments.render);
+    Trace_Close();
+    free(arguments.sources);
+    return result;
+  }
+  if (arguments.headless) {
+    arguments.query.sources = arguments.sources;
+    arguments.query.sourcesSize = arguments.sourcesSize;
+    arguments.query.verbosity = arguments.verbosity;
+    arguments.query.retention = arguments.retention;
+    if (arguments.traceFile) {
+      Trace_Open(arguments.traceFile);
+    }
+    const int result = Headless_Run(&arguments.query);
+    Trace_Close();
+    free(arguments.sources);
+    return result;
+  }
+
+  App* app = malloc(App_SizeOf());
 
   Config conf = {
-      .filePath = arguments.filePath,
+      .sources = arguments.sources,
+      .sourcesSize = arguments.sourcesSize,
       .style = 4,
+      .targetFps = arguments.targetFps,
+      .idleMode = arguments.idleMode,
+      .verbosity = arguments.verbosity,
+      .traceFile = arguments.traceFile,
+      .retention = arguments.retention,
   };
 
   App_Init(app);
@@ -40,5 +142,6 @@ int main(int argc, char** argv) {
 
   App_Destroy(app);
   free(app);
+  free(arguments.sources);
   return 0;
 }